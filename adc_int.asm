@@ -3,33 +3,90 @@
 ;#pragma vector=ADC12_VECTOR
 ;__interrupt void ADC12_ISR(void)
 ;{
-;	if(ADC12IV == 6) // Vector  6: ADC12IFG0
+;	unsigned int s1 = 0, s2 = 0;
+;	if(ADC12IV == ADC12IV_LAST)	// jedno citanje, kraj sekvence
 ;	{
-;		adc1val = ADC12MEM0;
-;	}
-;	if(ADC12IV == 8) // Vector  8: ADC12IFG1
-;	{
-;		adc2val = ADC12MEM1;
+;		for(k = 0; k < HAL_ADC_OVERSAMPLE; k++)
+;		{
+;			s1 += ADC12MEM[2*k];
+;			s2 += ADC12MEM[2*k+1];
+;		}
+;		adc1val = s1 >> HAL_ADC_OVERSAMPLE_SHIFT;
+;		adc2val = s2 >> HAL_ADC_OVERSAMPLE_SHIFT;
+;		HAL_PaddleHandler(adc1val, adc2val);
+;		ADC12CTL0 &= ~ADC12ENC;	// sledecu sekvencu pokrece
+;		ADC12CTL0 |= ADC12ENC;	// sledeca ivica TA0.1
 ;	}
 ;}
 ;
 ; Prekidna rutina ocitava vrednosti AD konvertora
 ; koji predstavlja trenutnu poziciju potenciometara.
-			.cdecls C,LIST,"msp430.h"
+; Prekid je dozvoljen samo za poslednju lokaciju sekvence (initADC),
+; pa se ADC12IV cita samo jednom: svako citanje brise indikator
+; prekida najveceg prioriteta.
+;
+; Rutina poziva C funkcije, pa mora da postuje model koda sa kojim je
+; projekat preveden: u velikom modelu (--code_model=large) C funkcije
+; se vracaju instrukcijom RETA i pozivaju sa CALLA. Registri se cuvaju
+; celi (20 bita, PUSHM.A), jer pozvana funkcija sme da menja i gornje
+; bitove. Rutina je u sekciji .text:_isr, koja je uvek ispod 64 KB, jer
+; je adresa u tabeli vektora 16-bitna.
+			.cdecls C,LIST,"msp430.h","hal.h","trace.h"
 
-			.ref adc1val			;promenljive iz main.c
+			.ref adc1val			;promenljive iz hal_msp430.c
 			.ref adc2val
+			.ref HAL_PaddleHandler	;obrada iz aplikacije (input.c)
+		.if TRACE_ENABLE
+			.ref Trace_Event		;zapis dogadjaja iz trace.c
+		.endif
+
+ADC12IV_LAST	.set 4*HAL_ADC_OVERSAMPLE+4	;ADC12IFG(2*N-1)
+
+		.if $isdefed("__LARGE_CODE_MODEL__")
+LARGE_CODE	.set __LARGE_CODE_MODEL__
+		.else
+LARGE_CODE	.set 0
+		.endif
+
+CALL_C		.macro fn				;poziv C funkcije u modelu koda projekta
+		.if LARGE_CODE
+			calla #fn
+		.else
+			call #fn
+		.endif
+			.endm
 
-			.text
+			.sect ".text:_isr"
 
-ADC12_ISR	cmp #6,ADC12IV
-			jnz ELSE
-			mov ADC12MEM0,adc1val
-;			jmp END
-ELSE		cmp #8,ADC12IV
+ADC12_ISR	pushm.a #5,R15			;R11 - R15 menjaju pozvane C funkcije
+		.if TRACE_ENABLE
+			mov.b #TRACE_ADC_ISR,R12
+			clr.b R13
+			CALL_C Trace_Event
+		.endif
+			cmp #ADC12IV_LAST,&ADC12IV
 			jnz END
-			mov ADC12MEM1,adc2val
-END			reti
+			clr R12					;zbir za igraca 1
+			clr R13					;zbir za igraca 2
+			.asg 0, K
+			.loop HAL_ADC_OVERSAMPLE
+			add &ADC12MEM0+4*K,R12	;lokacije 2k i 2k+1
+			add &ADC12MEM0+4*K+2,R13
+			.eval K+1, K
+			.endloop
+		.if HAL_ADC_OVERSAMPLE_SHIFT > 0
+			.loop HAL_ADC_OVERSAMPLE_SHIFT
+			rra R12					;zbir je manji od 2^15
+			rra R13
+			.endloop
+		.endif
+			mov R12,&adc1val
+			mov R13,&adc2val
+			bic #ADC12ENC,&ADC12CTL0	;sledecu sekvencu pokrece
+			bis #ADC12ENC,&ADC12CTL0	;sledeca ivica TA0.1
+			CALL_C HAL_PaddleHandler	;argumenti su u R12 i R13
+END			popm.a #5,R15
+			reti
 
 			.sect  .int55
 			.short ADC12_ISR
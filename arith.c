@@ -0,0 +1,89 @@
+/**
+ * @file arith.c
+ * @brief Deljenje i ostatak bez instrukcije deljenja
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ */
+#include "arith.h"
+
+/**
+ * @brief Kolicnik x / d
+ * @param Deljenik (0 - 65535)
+ * @param Delilac (2 - 65535)
+ * @param ARITH_RECIP(d)
+ * @return Kolicnik, isti kao x / d
+ *
+ * Posto je reciprocna vrednost zaokruzena nadole, procena
+ * (x * recip) >> 16 je manja od tacnog kolicnika najvise za 1, pa je
+ * dovoljna jedna popravka.
+ */
+uint16_t Arith_Div(uint16_t x, uint16_t d, uint16_t recip)
+{
+	uint16_t q = (uint16_t)(((uint32_t)x * recip) >> 16);
+	if((uint16_t)(x - q * d) >= d)
+		q++;
+	return q;
+}
+
+/**
+ * @brief Ostatak x % d
+ * @param Deljenik (0 - 65535)
+ * @param Delilac (2 - 65535)
+ * @param ARITH_RECIP(d)
+ * @return Ostatak, isti kao x % d
+ */
+uint16_t Arith_Mod(uint16_t x, uint16_t d, uint16_t recip)
+{
+	uint16_t r = x - (uint16_t)(((uint32_t)x * recip) >> 16) * d;
+	if(r >= d)
+		r -= d;
+	return r;
+}
+
+/**
+ * @brief Ostatak deljenja sa 2^k - 1
+ * @param Deljenik
+ * @param k (2 - 16)
+ * @return Ostatak, isti kao x % ((1 << k) - 1)
+ *
+ * Posto je 2^k = 1 po modulu 2^k - 1, visi bitovi se dodaju nizim
+ * dok zbir ne stane u k bitova.
+ */
+uint16_t Arith_ModMersenne(uint32_t x, uint8_t k)
+{
+	uint32_t m = ((uint32_t)1 << k) - 1;
+
+	while(x > m)
+		x = (x & m) + (x >> k);
+	return x == m ? 0 : (uint16_t)x;
+}
+
+/**
+ * @brief Razlomak num / den sa bits bitova iza zareza
+ * @param Brojilac (0 - den)
+ * @param Imenilac (1 - 32767)
+ * @param Broj bitova iza zareza
+ * @return (num << bits) / den, zaokruzeno nadole
+ *
+ * Deljenje se radi oduzimanjem, po jedan bit kolicnika u koraku, pa
+ * ima samo bits koraka umesto 16 ili 32 koliko ima bibliotecko deljenje.
+ */
+uint16_t Arith_Frac(uint16_t num, uint16_t den, uint8_t bits)
+{
+	uint16_t q = 0;
+
+	if(num >= den)
+		return (uint16_t)1 << bits;
+
+	while(bits--)
+	{
+		num <<= 1;
+		q <<= 1;
+		if(num >= den)
+		{
+			num -= den;
+			q |= 1;
+		}
+	}
+	return q;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file arith.h
+ * @brief Deljenje i ostatak bez instrukcije deljenja
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * MSP430 nema instrukciju deljenja, pa se svako / i % sa brojem koji
+ * nije stepen dvojke prevodi u poziv bibliotecke funkcije koja deli
+ * bit po bit. Ovde se deljenje konstantom zamenjuje mnozenjem
+ * reciprocnom vrednoscu (16 x 16 bita, hardverski mnozac MPY32 kada je
+ * ukljucena opcija --use_hw_mpy=F5), a deljenje kada je kolicnik mali
+ * skracenim deljenjem sa onoliko koraka koliko kolicnik ima bitova.
+ */
+#ifndef ARITH_H_
+#define ARITH_H_
+
+#include <stdint.h>
+
+/**
+ * Apsolutna vrednost bez poziva funkcije abs
+ */
+#define ARITH_ABS(x) ((x) < 0 ? -(x) : (x))
+
+/**
+ * Reciprocna vrednost delioca d (2 - 65535) u Q0.16, zaokruzena nadole
+ */
+#define ARITH_RECIP(d) ((uint16_t)(65536UL / (d)))
+
+/**
+ * Kolicnik i ostatak deljenja konstantom d (2 - 65535); reciprocna
+ * vrednost se racuna pri prevodjenju
+ */
+#define ARITH_DIV(x, d) Arith_Div((x), (d), ARITH_RECIP(d))
+#define ARITH_MOD(x, d) Arith_Mod((x), (d), ARITH_RECIP(d))
+
+/**
+ * @brief Kolicnik x / d
+ * @param Deljenik (0 - 65535)
+ * @param Delilac (2 - 65535)
+ * @param ARITH_RECIP(d)
+ * @return Kolicnik, isti kao x / d
+ */
+uint16_t Arith_Div(uint16_t, uint16_t, uint16_t);
+
+/**
+ * @brief Ostatak x % d
+ * @param Deljenik (0 - 65535)
+ * @param Delilac (2 - 65535)
+ * @param ARITH_RECIP(d)
+ * @return Ostatak, isti kao x % d
+ */
+uint16_t Arith_Mod(uint16_t, uint16_t, uint16_t);
+
+/**
+ * @brief Ostatak deljenja sa 2^k - 1
+ * @param Deljenik
+ * @param k (2 - 16)
+ * @return Ostatak, isti kao x % ((1 << k) - 1)
+ */
+uint16_t Arith_ModMersenne(uint32_t, uint8_t);
+
+/**
+ * @brief Razlomak num / den sa bits bitova iza zareza
+ * @param Brojilac (0 - den)
+ * @param Imenilac (1 - 32767)
+ * @param Broj bitova iza zareza
+ * @return (num << bits) / den, zaokruzeno nadole
+ */
+uint16_t Arith_Frac(uint16_t, uint16_t, uint8_t);
+
+#endif /* ARITH_H_ */
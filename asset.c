@@ -0,0 +1,143 @@
+/**
+ * @file asset.c
+ * @brief Dekodovanje kompresovanih slika
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Dekoder vraca nizove koji pokazuju direktno u flash memoriju, pa se
+ * slika moze slati na SPI (OLED_PutAsset) ili upisivati u bafer bez
+ * medjukoraka.
+ */
+#include "asset.h"
+#include "blit.h"
+#include "hal.h"
+#include "oled.h"
+
+/**
+ * Bajt na koji pokazuju nizovi nula
+ */
+static const uint8_t zero = 0;
+
+/**
+ * @brief Pocetak dekodovanja slike
+ * @param Stanje dekodera
+ * @param Kompresovana slika
+ */
+void Asset_Begin(AssetReader *r, const uint8_t *asset)
+{
+	r->src = asset;
+	r->page = asset;
+	r->resume = 0;
+	r->repeat = 0;
+	r->pos = 0;
+}
+
+/**
+ * @brief Sledeci niz bajtova slike
+ * @param Stanje dekodera
+ * @param Adresa na koju se upisuje niz
+ * @return 0 kada je dekodovana cela slika
+ *
+ * Na pocetku strane se pamti gde pocinju njeni tokeni. Kada se naidje
+ * na token ponavljanja strane, tokeni prethodne strane se citaju
+ * ponovo, a posle poslednjeg ponavljanja se nastavlja iza tokena.
+ */
+uint8_t Asset_Next(AssetReader *r, AssetRun *run)
+{
+	uint8_t t;
+
+	if(r->pos >= IMAGE_SIZE)
+		return 0;
+
+	HAL_COST(SIM_COST_ASSET_RUN);
+	if(r->pos % OLED_WIDTH == 0)
+	{
+		if(r->repeat)
+		{
+			r->repeat--;
+			r->src = r->page;
+		}
+		else
+		{
+			if(r->resume)
+			{
+				r->src = r->resume;
+				r->resume = 0;
+			}
+			if((*r->src & ASSET_OP) == ASSET_PAGE)
+			{
+				r->repeat = *r->src & ASSET_COUNT;
+				r->resume = r->src + 1;
+				r->src = r->page;
+			}
+			else
+				r->page = r->src;
+		}
+	}
+
+	t = *r->src++;
+	run->len = (t & ASSET_COUNT) + 1;
+	run->fill = 1;
+	switch(t & ASSET_OP)
+	{
+	case ASSET_LITERAL:
+		run->data = r->src;
+		run->fill = 0;
+		r->src += run->len;
+		break;
+	case ASSET_FILL:
+		run->data = r->src++;
+		break;
+	default:
+		run->data = &zero;
+		break;
+	}
+	r->pos += run->len;
+	return 1;
+}
+
+/**
+ * @brief Dekodovanje cele slike u bafer
+ * @param Kompresovana slika
+ * @param Bafer od IMAGE_SIZE bajtova
+ */
+void Asset_Decode(const uint8_t *asset, uint8_t *dst)
+{
+	Asset_DecodeRange(asset, 0, IMAGE_SIZE, dst);
+}
+
+/**
+ * @brief Dekodovanje dela slike
+ * @param Kompresovana slika
+ * @param Redni broj prvog bajta u slici
+ * @param Broj bajtova
+ * @param Adresa na koju se upisuje prvi bajt
+ *
+ * Nizovi ispred trazenog dela se samo preskacu.
+ */
+void Asset_DecodeRange(const uint8_t *asset, unsigned int start,
+		unsigned int len, uint8_t *dst)
+{
+	AssetReader r;
+	AssetRun run;
+	unsigned int end = start + len;
+	unsigned int pos, from, to;
+
+	Asset_Begin(&r, asset);
+	while(Asset_Next(&r, &run))
+	{
+		pos = r.pos - run.len;
+		if(r.pos <= start)
+			continue;
+		if(pos >= end)
+			break;
+
+		from = pos < start ? start - pos : 0;
+		to = r.pos > end ? end - pos : run.len;
+		HAL_COST(SIM_COST_COPY_WORD * ((to - from + 1) >> 1));
+		if(run.fill)
+			Blit_Fill(dst + pos + from - start, run.data[0], to - from);
+		else
+			Blit_Copy(dst + pos + from - start, run.data + from, to - from);
+	}
+}
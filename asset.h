@@ -0,0 +1,107 @@
+/**
+ * @file asset.h
+ * @brief Kompresovane slike u flash memoriji i njihovo dekodovanje
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Slika od IMAGE_SIZE bajtova (redosled kao u GDDRAM-u: strana po
+ * strana, kolona po kolona) se cuva kao niz tokena. Gornja dva bita
+ * tokena odredjuju vrstu, a donjih 6 bitova broj n - 1 (n = 1 - 64):
+ *
+ *  00nnnnnn  n bajtova koji slede se prepisuju
+ *  01nnnnnn  sledeci bajt se ponavlja n puta
+ *  10nnnnnn  n nula
+ *  11nnnnnn  sledecih n strana je isto kao prethodna strana
+ *
+ * Token ponavljanja strane se nalazi samo na pocetku strane, a nizovi
+ * se ne prostiru preko granice strane. Dekoder ponavlja tokene
+ * prethodne strane, pa mu ne treba bafer za vec dekodovane bajtove.
+ *
+ * Slike se prave iz PBM fajlova programom pbm2asset (asset_data.c).
+ */
+#ifndef ASSET_H_
+#define ASSET_H_
+
+#include <stdint.h>
+
+/**
+ * Vrste tokena
+ */
+#define ASSET_OP       0xC0
+#define ASSET_LITERAL  0x00
+#define ASSET_FILL     0x40
+#define ASSET_ZERO     0x80
+#define ASSET_PAGE     0xC0
+
+/**
+ * Maska broja ponavljanja u tokenu
+ */
+#define ASSET_COUNT    0x3F
+
+/**
+ * Najduzi niz koji se moze zapisati jednim tokenom
+ */
+#define ASSET_MAX_RUN  (ASSET_COUNT + 1)
+
+/**
+ * Stanje dekodera
+ */
+typedef struct
+{
+	const uint8_t *src;		// sledeci token
+	const uint8_t *page;	// tokeni poslednje zapisane strane
+	const uint8_t *resume;	// nastavak posle tokena ponavljanja strane
+	uint8_t repeat;			// preostali broj ponavljanja strane
+	unsigned int pos;		// broj dekodovanih bajtova
+} AssetReader;
+
+/**
+ * Jedan niz bajtova slike
+ */
+typedef struct
+{
+	const uint8_t *data;	// bajtovi u flash memoriji
+	uint8_t len;
+	uint8_t fill;			// 1 - data[0] se ponavlja len puta
+} AssetRun;
+
+/**
+ * Slike (asset_data.c)
+ */
+extern const uint8_t background[];
+extern const uint8_t start_screen[];
+extern const uint8_t logo[];
+extern const uint8_t pic[];
+
+/**
+ * @brief Pocetak dekodovanja slike
+ * @param Stanje dekodera
+ * @param Kompresovana slika
+ */
+void Asset_Begin(AssetReader *, const uint8_t *);
+
+/**
+ * @brief Sledeci niz bajtova slike
+ * @param Stanje dekodera
+ * @param Adresa na koju se upisuje niz
+ * @return 0 kada je dekodovana cela slika
+ */
+uint8_t Asset_Next(AssetReader *, AssetRun *);
+
+/**
+ * @brief Dekodovanje cele slike u bafer
+ * @param Kompresovana slika
+ * @param Bafer od IMAGE_SIZE bajtova
+ */
+void Asset_Decode(const uint8_t *, uint8_t *);
+
+/**
+ * @brief Dekodovanje dela slike
+ * @param Kompresovana slika
+ * @param Redni broj prvog bajta u slici
+ * @param Broj bajtova
+ * @param Adresa na koju se upisuje prvi bajt
+ */
+void Asset_DecodeRange(const uint8_t *, unsigned int, unsigned int, uint8_t *);
+
+#endif /* ASSET_H_ */
@@ -0,0 +1,80 @@
+/**
+ * @file asset_data.c
+ * @brief Kompresovane slike (napravio pbm2asset, ne menjati rucno)
+ */
+#include <stdint.h>
+
+#include "asset.h"
+
+/**
+ * background.pbm: 6 bajtova (nekompresovano 480)
+ */
+const uint8_t background[] = {
+		0xAE, 0x01, 0x66, 0x66, 0xAE, 0xC3
+};
+
+/**
+ * start_screen.pbm: 169 bajtova (nekompresovano 480)
+ */
+const uint8_t start_screen[] = {
+		0xBF, 0x9F, 0x8B, 0x02, 0x01, 0x01, 0x03, 0x42, 0xFF, 0x42, 0x01, 0x04, 0x03, 0x87, 0xFE, 0xFC,
+		0x78, 0x81, 0x05, 0xE0, 0xF0, 0xFC, 0x1C, 0x06, 0x02, 0x44, 0x01, 0x05, 0x03, 0x06, 0x1C, 0xFC,
+		0xF0, 0xE0, 0x42, 0x01, 0x09, 0x03, 0xFF, 0x1F, 0x1E, 0x7C, 0xF0, 0xE0, 0xC0, 0x80, 0x00, 0x42,
+		0x01, 0x0B, 0xFF, 0x03, 0x01, 0x01, 0x00, 0xC0, 0xF0, 0xF8, 0x3C, 0x0E, 0x02, 0x03, 0x44, 0x01,
+		0x03, 0x02, 0x06, 0x1F, 0x10, 0x8D, 0x8E, 0x42, 0xFF, 0x42, 0x02, 0x03, 0x03, 0x03, 0x01, 0x01,
+		0x82, 0x04, 0x1F, 0x7F, 0xFF, 0xE0, 0x80, 0x86, 0x04, 0x80, 0xE0, 0xFF, 0x3F, 0x1F, 0x83, 0x00,
+		0xFF, 0x83, 0x07, 0x01, 0x03, 0x0F, 0x1E, 0x3C, 0xF8, 0xF0, 0xFF, 0x83, 0x05, 0x1F, 0x3F, 0xFF,
+		0xF0, 0xC0, 0x80, 0x84, 0x01, 0x01, 0x01, 0x42, 0xFF, 0x01, 0x01, 0x01, 0x8B, 0x8B, 0x01, 0x02,
+		0x02, 0x43, 0x03, 0x01, 0x02, 0x02, 0x8A, 0x02, 0x01, 0x01, 0x03, 0x44, 0x02, 0x01, 0x01, 0x01,
+		0x84, 0x42, 0x02, 0x00, 0x03, 0x42, 0x02, 0x86, 0x01, 0x01, 0x03, 0x87, 0x02, 0x01, 0x01, 0x03,
+		0x44, 0x02, 0x00, 0x03, 0x42, 0x01, 0x8D, 0xBF, 0x9F
+};
+
+/**
+ * logo.pbm: 251 bajtova (nekompresovano 480)
+ */
+const uint8_t logo[] = {
+		0x84, 0x03, 0x80, 0xC0, 0xC0, 0xE0, 0x42, 0xF0, 0x4C, 0xF8, 0x06, 0xF0, 0xF0, 0xE0, 0x80, 0x70,
+		0xF0, 0xF0, 0xBF, 0x03, 0xC0, 0xF0, 0xFC, 0xFE, 0x43, 0xFF, 0x07, 0x7F, 0x3F, 0x0F, 0x07, 0x03,
+		0x07, 0x1F, 0x7F, 0x44, 0xFF, 0x0C, 0x7F, 0x1F, 0x0F, 0x07, 0x07, 0x0F, 0x3F, 0x7F, 0xFE, 0xFC,
+		0xF0, 0xE0, 0x80, 0xBD, 0x42, 0xFF, 0x0A, 0x3F, 0x1F, 0x07, 0x0F, 0x1F, 0x7F, 0xFE, 0xF8, 0xF0,
+		0xC0, 0x80, 0x82, 0x08, 0x03, 0x07, 0x1F, 0x3F, 0xFF, 0xFC, 0xF8, 0xE0, 0x80, 0x82, 0x08, 0x01,
+		0x03, 0x0F, 0x3F, 0x7F, 0xFF, 0xFC, 0xF0, 0xE0, 0xB9, 0x01, 0x03, 0x01, 0x82, 0x03, 0xC0, 0xE0,
+		0xF0, 0xFC, 0x44, 0xFF, 0x07, 0xFE, 0xF8, 0xF0, 0xC0, 0x80, 0xC0, 0xE0, 0xF0, 0x44, 0xFF, 0x03,
+		0xFC, 0xF8, 0xE0, 0xC0, 0x82, 0x05, 0x01, 0x03, 0x03, 0xF8, 0xFC, 0x06, 0x43, 0x02, 0x03, 0x06,
+		0x00, 0xF8, 0xF8, 0x82, 0x01, 0xF8, 0xF8, 0x81, 0x1E, 0xF8, 0xF8, 0x10, 0x18, 0x18, 0x00, 0xFB,
+		0xFB, 0x00, 0xE0, 0xF0, 0x18, 0x08, 0x08, 0x18, 0xF0, 0xE0, 0x00, 0x30, 0x78, 0x68, 0xC8, 0xC8,
+		0x98, 0x00, 0xFB, 0xFB, 0x00, 0x08, 0xFE, 0xFE, 0x43, 0x08, 0x05, 0x78, 0xF0, 0x80, 0x80, 0xF0,
+		0x78, 0x83, 0x04, 0x01, 0x03, 0x07, 0x07, 0x0F, 0x42, 0x1F, 0x4C, 0x3F, 0x42, 0x1F, 0x03, 0x0F,
+		0x07, 0x07, 0x03, 0x85, 0x01, 0x01, 0x03, 0x43, 0x02, 0x03, 0x03, 0x00, 0x01, 0x03, 0x42, 0x02,
+		0x01, 0x03, 0x03, 0x81, 0x01, 0x03, 0x03, 0x83, 0x01, 0x03, 0x03, 0x81, 0x05, 0x01, 0x03, 0x02,
+		0x02, 0x03, 0x01, 0x81, 0x00, 0x03, 0x42, 0x02, 0x04, 0x03, 0x01, 0x00, 0x03, 0x03, 0x81, 0x01,
+		0x01, 0x03, 0x42, 0x02, 0x81, 0x04, 0x11, 0x1F, 0x0F, 0x01, 0x00
+};
+
+/**
+ * pic.pbm: 328 bajtova (nekompresovano 480)
+ */
+const uint8_t pic[] = {
+		0x06, 0xFF, 0xFF, 0x3F, 0x1F, 0x0F, 0x07, 0x07, 0x46, 0x03, 0x01, 0xE3, 0xE3, 0x43, 0x03, 0x02,
+		0xC3, 0xE3, 0xC3, 0x43, 0x03, 0x01, 0xE3, 0xE3, 0x47, 0x03, 0x01, 0xC3, 0xC3, 0x44, 0x63, 0x03,
+		0xE3, 0xE3, 0x03, 0x03, 0x46, 0x63, 0x01, 0xE3, 0xE3, 0x47, 0x03, 0x01, 0xE3, 0xE3, 0x42, 0x03,
+		0x01, 0xC3, 0xC3, 0x43, 0x63, 0x01, 0xC3, 0xC3, 0x4A, 0x03, 0x06, 0x07, 0x07, 0x0F, 0x1F, 0x3F,
+		0xFF, 0xFF, 0x00, 0xFF, 0x8D, 0x0C, 0x03, 0x1F, 0xF8, 0xC0, 0xFE, 0x1F, 0x00, 0x1F, 0xFE, 0xC0,
+		0xF8, 0x1F, 0x03, 0x87, 0x02, 0x3F, 0xFF, 0xC0, 0x44, 0x80, 0x01, 0xFF, 0xFF, 0x81, 0x46, 0x8C,
+		0x01, 0xFF, 0xFF, 0x81, 0x45, 0x80, 0x01, 0xFF, 0xFF, 0x81, 0x02, 0x3F, 0xFF, 0xC0, 0x43, 0x80,
+		0x02, 0xC0, 0xFF, 0x3F, 0x8F, 0x00, 0xFF, 0x00, 0xFF, 0x88, 0x47, 0x80, 0x01, 0x81, 0x01, 0x82,
+		0x01, 0x01, 0x01, 0x8D, 0x42, 0x01, 0x07, 0x81, 0x81, 0x01, 0x01, 0x80, 0x80, 0x01, 0x01, 0x42,
+		0xC1, 0x00, 0x81, 0x42, 0x01, 0x81, 0x00, 0x81, 0x42, 0xC1, 0x43, 0x01, 0x84, 0x43, 0x01, 0x87,
+		0x01, 0x80, 0x80, 0x88, 0x00, 0xFF, 0x00, 0xFF, 0x88, 0x46, 0x31, 0x01, 0xFF, 0xFF, 0x81, 0x0D,
+		0xF0, 0xF8, 0x1C, 0x0C, 0x0C, 0x1C, 0xF8, 0xF0, 0x00, 0x0C, 0x0C, 0x18, 0xFC, 0xFC, 0x81, 0x06,
+		0x04, 0x8C, 0xF8, 0x70, 0xE0, 0xFF, 0xFF, 0x81, 0x01, 0xFD, 0xFD, 0x81, 0x0C, 0xFF, 0xFF, 0x03,
+		0x1F, 0xFC, 0xC0, 0x00, 0xC0, 0xFC, 0x1F, 0x03, 0xFF, 0xFF, 0x84, 0x11, 0x0C, 0x3C, 0xF0, 0xC0,
+		0x00, 0xC0, 0xF0, 0x3C, 0x0C, 0x00, 0xF0, 0xF8, 0x1C, 0x0C, 0x0C, 0x18, 0xFF, 0xFF, 0x88, 0x00,
+		0xFF, 0x06, 0xFF, 0xFE, 0xF8, 0xF0, 0xE0, 0xC0, 0xC0, 0x42, 0x80, 0x46, 0x86, 0x0B, 0x87, 0x87,
+		0x80, 0x80, 0x81, 0x83, 0x87, 0x86, 0x86, 0x87, 0x83, 0x81, 0x43, 0x80, 0x1D, 0x87, 0x87, 0x80,
+		0x80, 0x86, 0x87, 0x81, 0x80, 0x80, 0x87, 0x87, 0x80, 0x80, 0x87, 0x87, 0x80, 0x80, 0x87, 0x87,
+		0x80, 0x80, 0x81, 0x87, 0x86, 0x87, 0x81, 0x80, 0x80, 0x87, 0x87, 0x46, 0x80, 0x0F, 0x81, 0x87,
+		0x9F, 0xBF, 0xB1, 0xB0, 0x80, 0x80, 0x81, 0x83, 0x87, 0x86, 0x86, 0x83, 0x87, 0x87, 0x42, 0x80,
+		0x06, 0xC0, 0xC0, 0xE0, 0xF0, 0xF8, 0xFE, 0xFF
+};
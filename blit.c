@@ -0,0 +1,166 @@
+/**
+ * @file blit.c
+ * @brief Operacije nad nizovima bajtova slike, 16 bita odjednom
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Svaka funkcija prvo obradi jedan bajt ako je odrediste na neparnoj
+ * adresi, zatim reci, pa poslednji bajt ako je ostao. Kada izvor i
+ * odrediste nemaju istu parnost, sve se radi bajt po bajt.
+ */
+#include <stdint.h>
+
+#include "blit.h"
+
+/**
+ * Adresa je neparna
+ */
+#define ODD(p) ((uintptr_t)(p) & 1)
+
+/**
+ * @brief Kopiranje niza bajtova
+ * @param Odrediste
+ * @param Izvor
+ * @param Broj bajtova
+ */
+void Blit_Copy(uint8_t *dst, const uint8_t *src, unsigned int len)
+{
+	BlitWord *dw;
+	const BlitWord *sw;
+	unsigned int n;
+
+	if(ODD(dst) == ODD(src))
+	{
+		if(ODD(dst) && len)
+		{
+			*dst++ = *src++;
+			len--;
+		}
+		dw = (BlitWord *)dst;
+		sw = (const BlitWord *)src;
+		for(n = len >> 1; n; n--)
+			*dw++ = *sw++;
+		dst = (uint8_t *)dw;
+		src = (const uint8_t *)sw;
+		len &= 1;
+	}
+	while(len--)
+		*dst++ = *src++;
+}
+
+/**
+ * @brief Popunjavanje niza bajtova istom vrednoscu
+ * @param Odrediste
+ * @param Vrednost
+ * @param Broj bajtova
+ */
+void Blit_Fill(uint8_t *dst, uint8_t v, unsigned int len)
+{
+	BlitWord *dw;
+	BlitWord w = v | ((BlitWord)v << 8);
+	unsigned int n;
+
+	if(ODD(dst) && len)
+	{
+		*dst++ = v;
+		len--;
+	}
+	dw = (BlitWord *)dst;
+	for(n = len >> 1; n; n--)
+		*dw++ = w;
+	if(len & 1)
+		*(uint8_t *)dw = v;
+}
+
+/**
+ * @brief Maskiranje niza bajtova: b = (b & keep) | set
+ * @param Odrediste
+ * @param Maska bitova koji se zadrzavaju
+ * @param Maska bitova koji se postavljaju
+ * @param Broj bajtova
+ *
+ * Sa keep = 0xFF je to OR, a sa set = 0 AND sa maskom.
+ */
+void Blit_Mask(uint8_t *dst, uint8_t keep, uint8_t set, unsigned int len)
+{
+	BlitWord *dw;
+	BlitWord wa = keep | ((BlitWord)keep << 8);
+	BlitWord wo = set | ((BlitWord)set << 8);
+	unsigned int n;
+
+	if(ODD(dst) && len)
+	{
+		*dst = (*dst & keep) | set;
+		dst++;
+		len--;
+	}
+	dw = (BlitWord *)dst;
+	for(n = len >> 1; n; n--, dw++)
+		*dw = (*dw & wa) | wo;
+	if(len & 1)
+	{
+		dst = (uint8_t *)dw;
+		*dst = (*dst & keep) | set;
+	}
+}
+
+/**
+ * @brief Invertovanje bitova niza bajtova: b ^= x
+ * @param Odrediste
+ * @param Maska bitova koji se invertuju
+ * @param Broj bajtova
+ */
+void Blit_Xor(uint8_t *dst, uint8_t x, unsigned int len)
+{
+	BlitWord *dw;
+	BlitWord wx = x | ((BlitWord)x << 8);
+	unsigned int n;
+
+	if(ODD(dst) && len)
+	{
+		*dst++ ^= x;
+		len--;
+	}
+	dw = (BlitWord *)dst;
+	for(n = len >> 1; n; n--)
+		*dw++ ^= wx;
+	if(len & 1)
+		*(uint8_t *)dw ^= x;
+}
+
+/**
+ * @brief Duzina jednakog pocetka dva niza bajtova
+ * @param Prvi niz
+ * @param Drugi niz
+ * @param Broj bajtova
+ * @return Broj jednakih bajtova pre prve razlike
+ *
+ * Reci se porede dok su jednake; u reci koja se razlikuje se trazi
+ * bajt koji se razlikuje.
+ */
+unsigned int Blit_Same(const uint8_t *a, const uint8_t *b, unsigned int len)
+{
+	const BlitWord *wa, *wb;
+	unsigned int k = 0;
+
+	if(ODD(a) == ODD(b))
+	{
+		if(ODD(a) && len)
+		{
+			if(a[0] != b[0])
+				return 0;
+			k = 1;
+		}
+		wa = (const BlitWord *)(a + k);
+		wb = (const BlitWord *)(b + k);
+		while(k + 1 < len && *wa == *wb)
+		{
+			wa++;
+			wb++;
+			k += 2;
+		}
+	}
+	while(k < len && a[k] == b[k])
+		k++;
+	return k;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file blit.h
+ * @brief Operacije nad nizovima bajtova slike, 16 bita odjednom
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * MSP430 je 16-bitni procesor, pa se kopiranje, popunjavanje i
+ * maskiranje rade rec po rec kad god odrediste i izvor imaju istu
+ * parnost adrese; samo neparan bajt na pocetku i na kraju se obradjuje
+ * posebno. Baferi slike i strane su deklarisani kao unije sa nizom
+ * reci (BlitImage, BlitPage), pa su poravnati na rec, a isti pomeraj u
+ * dva takva bafera uvek ima istu parnost.
+ */
+#ifndef BLIT_H_
+#define BLIT_H_
+
+#include <stdint.h>
+
+#include "oled.h"
+
+/**
+ * 16-bitna rec kojom se pristupa nizu bajtova (GCC inace pretpostavlja
+ * da se uint8_t i uint16_t pokazivaci ne preklapaju)
+ */
+#if defined(__GNUC__)
+typedef uint16_t __attribute__((__may_alias__)) BlitWord;
+#else
+typedef uint16_t BlitWord;
+#endif
+
+/**
+ * Strana pocinje na parnoj adresi u baferu slike
+ */
+typedef char blit_page_is_even[OLED_WIDTH % 2 == 0 ? 1 : -1];
+typedef char blit_image_is_even[IMAGE_SIZE % 2 == 0 ? 1 : -1];
+
+/**
+ * Bafer slike poravnat na rec
+ */
+typedef union
+{
+	uint8_t b[IMAGE_SIZE];
+	BlitWord w[IMAGE_SIZE / 2];
+} BlitImage;
+
+/**
+ * Bafer jedne strane poravnat na rec
+ */
+typedef union
+{
+	uint8_t b[OLED_WIDTH];
+	BlitWord w[OLED_WIDTH / 2];
+} BlitPage;
+
+/**
+ * @brief Kopiranje niza bajtova
+ * @param Odrediste
+ * @param Izvor
+ * @param Broj bajtova
+ */
+void Blit_Copy(uint8_t *, const uint8_t *, unsigned int);
+
+/**
+ * @brief Popunjavanje niza bajtova istom vrednoscu
+ * @param Odrediste
+ * @param Vrednost
+ * @param Broj bajtova
+ */
+void Blit_Fill(uint8_t *, uint8_t, unsigned int);
+
+/**
+ * @brief Maskiranje niza bajtova: b = (b & keep) | set
+ * @param Odrediste
+ * @param Maska bitova koji se zadrzavaju
+ * @param Maska bitova koji se postavljaju
+ * @param Broj bajtova
+ */
+void Blit_Mask(uint8_t *, uint8_t, uint8_t, unsigned int);
+
+/**
+ * @brief Invertovanje bitova niza bajtova: b ^= x
+ * @param Odrediste
+ * @param Maska bitova koji se invertuju
+ * @param Broj bajtova
+ */
+void Blit_Xor(uint8_t *, uint8_t, unsigned int);
+
+/**
+ * @brief Duzina jednakog pocetka dva niza bajtova
+ * @param Prvi niz
+ * @param Drugi niz
+ * @param Broj bajtova
+ * @return Broj jednakih bajtova pre prve razlike
+ */
+unsigned int Blit_Same(const uint8_t *, const uint8_t *, unsigned int);
+
+#endif /* BLIT_H_ */
@@ -0,0 +1,86 @@
+/**
+ * @file event.c
+ * @brief Red ulaznih dogadjaja od prekidnih rutina do glavnog programa
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ */
+#include "event.h"
+#include "hal.h"
+
+typedef char event_queue_pow2[(EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) == 0 ? 1 : -1];
+
+/**
+ * Kruzni bafer dogadjaja. Mesta su volatile kao i indeksi, da prevodilac
+ * ne bi premestio upis ili citanje dogadjaja preko pristupa indeksu
+ * (upis posle pomeranja tail, citanje pre provere tail).
+ */
+static volatile Event queue[EVENT_QUEUE_SIZE];
+
+/**
+ * Indeks najstarijeg dogadjaja i indeks prvog slobodnog mesta
+ */
+static volatile uint8_t head = 0, tail = 0;
+
+/**
+ * Broj odbacenih dogadjaja
+ */
+static volatile uint16_t dropped = 0;
+
+/**
+ * @brief Upis dogadjaja (poziva se iz prekidne rutine)
+ * @param Tip dogadjaja
+ * @param Kanal (redni broj igraca)
+ * @param Vrednost
+ * @return 0 ako je red pun i dogadjaj je odbacen
+ *
+ * Dogadjaj se prvo popuni, pa se tek onda pomera tail, da potrosac
+ * nikad ne procita nepotpun dogadjaj.
+ */
+uint8_t Event_Push(uint8_t type, uint8_t ch, uint16_t value)
+{
+	uint8_t t = tail;
+	uint8_t next = (t + 1) & (EVENT_QUEUE_SIZE - 1);
+	volatile Event *e;
+
+	if(next == head)
+	{
+		dropped++;
+		return 0;
+	}
+	e = &queue[t];
+	e->stamp = HAL_TIMESTAMP();
+	e->type = type;
+	e->ch = ch;
+	e->value = value;
+	tail = next;
+	return 1;
+}
+
+/**
+ * @brief Citanje najstarijeg dogadjaja (poziva glavni program)
+ * @param Adresa na koju se upisuje dogadjaj
+ * @return 0 ako je red prazan
+ */
+uint8_t Event_Pop(Event *out)
+{
+	uint8_t h = head;
+	volatile Event *e;
+
+	if(h == tail)
+		return 0;
+	e = &queue[h];
+	out->stamp = e->stamp;
+	out->type = e->type;
+	out->ch = e->ch;
+	out->value = e->value;
+	head = (h + 1) & (EVENT_QUEUE_SIZE - 1);
+	return 1;
+}
+
+/**
+ * @brief Broj odbacenih dogadjaja od pokretanja
+ */
+uint16_t Event_Dropped(void)
+{
+	return dropped;
+}
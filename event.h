@@ -0,0 +1,66 @@
+/**
+ * @file event.h
+ * @brief Red ulaznih dogadjaja od prekidnih rutina do glavnog programa
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Prekidne rutine (AD konvertor, taster) upisuju dogadjaje sa vremenom
+ * nastanka (HAL_TIMESTAMP), a glavni program ih cita. Red ima jednog
+ * proizvodjaca i jednog potrosaca, pa indeksi ne zahtevaju
+ * zakljucavanje: proizvodjac menja samo tail, a potrosac samo head.
+ * Vise prekidnih rutina se racuna kao jedan proizvodjac, jer se na
+ * MSP430 prekidne rutine ne prekidaju medjusobno.
+ *
+ * Kada je red pun, novi dogadjaj se odbacuje i broji (Event_Dropped),
+ * pa glavni program zna da je propustio odbirke.
+ */
+#ifndef EVENT_H_
+#define EVENT_H_
+
+#include <stdint.h>
+
+/**
+ * Broj mesta u redu, mora biti stepen broja 2 (jedno mesto ostaje
+ * prazno)
+ */
+#define EVENT_QUEUE_SIZE 16
+
+/**
+ * Tipovi dogadjaja
+ */
+#define EVENT_PADDLE 1	// odbirak potenciometra, ch = igrac, value = vrednost
+#define EVENT_BUTTON 2	// pritisak tastera S4
+
+/**
+ * Jedan dogadjaj
+ */
+typedef struct
+{
+	uint16_t stamp;		// HAL_TIMESTAMP() u trenutku upisa
+	uint8_t type;
+	uint8_t ch;
+	uint16_t value;
+} Event;
+
+/**
+ * @brief Upis dogadjaja (poziva se iz prekidne rutine)
+ * @param Tip dogadjaja
+ * @param Kanal (redni broj igraca)
+ * @param Vrednost
+ * @return 0 ako je red pun i dogadjaj je odbacen
+ */
+uint8_t Event_Push(uint8_t, uint8_t, uint16_t);
+
+/**
+ * @brief Citanje najstarijeg dogadjaja (poziva glavni program)
+ * @param Adresa na koju se upisuje dogadjaj
+ * @return 0 ako je red prazan
+ */
+uint8_t Event_Pop(Event *);
+
+/**
+ * @brief Broj odbacenih dogadjaja od pokretanja
+ */
+uint16_t Event_Dropped(void);
+
+#endif /* EVENT_H_ */
@@ -5,10 +5,22 @@
  * @date 2016
  */
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "arith.h"
+#include "asset.h"
+#include "blit.h"
 #include "game.h"
-#include "lut.h"
+#include "hal.h"
+#include "hud.h"
+#include "input.h"
 #include "oled.h"
+#include "prng.h"
+#include "profile.h"
+#include "sprite.h"
+#include "text.h"
+#include "trace.h"
 
 /**
  * Velicina loptice
@@ -18,13 +30,23 @@
 /**
  * Maska koja se koristi za iscrtavanje loptice
  */
-#define BALL_MASK 7
+#define BALL_MASK ((1 << BALL_SIZE) - 1)
 
 /**
  * Velicina igraca
  */
 #define PLANK_SIZE 8
 
+/**
+ * Maska koja se koristi za iscrtavanje igraca
+ */
+#define PLANK_MASK ((1 << PLANK_SIZE) - 1)
+
+/**
+ * Sirina igraca u kolonama
+ */
+#define PLANK_WIDTH 2
+
 /**
  * Red u kome se ispisuje rezultat prvog igraca
  */
@@ -45,16 +67,6 @@
  */
 #define SCORE2_COL 52
 
-/**
- * Razmak izmedju dve cifre u rezultatu
- */
-#define NUM_OFFSET  6
-
-/**
- * Broj kolona koje zauzima jedna cifra
- */
-#define NUM_OF_COLS 5
-
 /**
  * Maksimalan pomeraj loptice po Y osi
  */
@@ -67,18 +79,86 @@
 
 /**
  * Vrednost koja definise posle koliko se generise nova loptica posle postizanja poena
+ * (u prekidima tajmera)
  */
 #define IDLE_WAIT 10
 
+/**
+ * Broj koraka simulacije po prekidu tajmera. Fizika se racuna sa
+ * stalnim korakom (HAL_TIMER_HZ / HAL_TIMER_PERIOD * PHYS_STEPS_PER_TICK
+ * koraka u sekundi), nezavisno od toga koliko se frejmova iscrta.
+ */
+#define PHYS_STEPS_PER_TICK 4
+
+/**
+ * Najveci broj koraka simulacije u jednom frejmu; ako je igra kasnila
+ * duze od toga, visak vremena se odbacuje.
+ */
+#define PHYS_MAX_STEPS (4 * PHYS_STEPS_PER_TICK)
+
+/**
+ * Polozaj i brzina loptice su u formatu Q8.8 (8 bita razlomljenog dela),
+ * pa staju u 16-bitni int na MSP430.
+ */
+#define FIX_SHIFT 8
+#define FIX_ONE   (1 << FIX_SHIFT)
+#define TO_FIX(a)   ((a) << FIX_SHIFT)
+#define FROM_FIX(a) (((a) + (FIX_ONE >> 1)) >> FIX_SHIFT)
+
+/**
+ * Pomeraj od s piksela po prekidu tajmera, izrazen kao brzina u Q8.8
+ * po koraku simulacije
+ */
+#define STEP_TO_FIX(s) ((s) * (FIX_ONE / PHYS_STEPS_PER_TICK))
+
+/**
+ * Granice kretanja centra loptice u Q8.8: po X osi su to ravni igraca,
+ * a po Y osi gornji i donji zid
+ */
+#define X_MIN TO_FIX((BALL_SIZE>>1) + 2)
+#define X_MAX TO_FIX(OLED_WIDTH - (BALL_SIZE>>1) - 3)
+#define Y_MIN TO_FIX(BALL_SIZE>>1)
+#define Y_MAX TO_FIX(8*OLED_BYTE_HEIGHT - 1 - (BALL_SIZE>>1))
+
+/**
+ * Najveci broj udaraca u igrace koji se obradjuju u jednom koraku
+ */
+#define MAX_BOUNCES 4
+
+/**
+ * U rezimu sa vise loptica, posle svakih MULTIBALL_RALLY odbijanja
+ * dodaje se nova loptica
+ */
+#define MULTIBALL_RALLY 6
+
+/**
+ * Povecanje brzine po X osi posle svakog udarca u igraca (Q8.8 po
+ * koraku) i najveca brzina koju loptica moze da dostigne
+ */
+#define RALLY_SPEEDUP (STEP_TO_FIX(1) / 8)
+#define MAX_X_SPEED   STEP_TO_FIX(3 * DEF_X_STEP)
+
 /**
  * Rezultati prvog i drugog igraca
  */
 static unsigned int score1 = 0, score2 = 0;
 
 /**
- * X i Y koordinata loptice
+ * Stanje loptica se cuva kao struktura nizova (jedan niz po velicini),
+ * pa se u svakom prolazu (fizika, iscrtavanje) niz obilazi redom.
+ * Aktivne loptice su na pocetku nizova (indeksi 0 do balls - 1).
  */
-static int xpos, ypos;
+
+/**
+ * X i Y koordinata loptica u pikselima, zaokruzene iz polozaja u Q8.8;
+ * koriste se za iscrtavanje i proveru udarca u dasku
+ */
+static int xpos[MAX_BALLS], ypos[MAX_BALLS];
+
+/**
+ * Polozaj centra loptica u Q8.8
+ */
+static int fxpos[MAX_BALLS], fypos[MAX_BALLS];
 
 /**
  * Vrednosti koje definisu polozaj igraca
@@ -86,14 +166,124 @@ static int xpos, ypos;
 static int bpos1 = 15, bpos2 = 15;
 
 /**
- * Broj koraka koje loptica pravi posle svakog frejma
+ * Brzina loptica u Q8.8 piksela po koraku simulacije
+ */
+static int xstep[MAX_BALLS], ystep[MAX_BALLS];
+
+/**
+ * Broj aktivnih loptica
+ */
+static uint8_t balls = 0;
+
+/**
+ * Rezim sa vise loptica i broj odbijanja od poslednjeg servisa
+ */
+static uint8_t multiball = MULTIBALL_ENABLE;
+static unsigned int rally = 0;
+
+/**
+ * Broj odbijanja posle kog se dodaje sledeca loptica
+ */
+static unsigned int next_spawn = MULTIBALL_RALLY;
+
+/**
+ * Broj koraka simulacije koji jos nisu izvrseni
+ */
+static unsigned int pending_steps = 0;
+
+#if RENDER_STREAM
+/**
+ * Bafer za jednu stranu: slika se iscrtava i salje strana po stranu
+ */
+static BlitPage pagebuf;
+#else
+/**
+ * Dva bafera frejma: dok se jedan salje na OLED, u drugi se iscrtava
+ * sledeci frejm
+ */
+static BlitImage framebuf[2];
+
+/**
+ * Indeks bafera u koji se trenutno iscrtava
+ */
+static uint8_t back = 0;
+
+/**
+ * Trenutni frejm koji se iscrtava (bafer sa indeksom back)
+ */
+uint8_t *playground = framebuf[0].b;
+#endif
+
+/**
+ * Sprajt mora da stane u dve susedne strane i u SPRITE_MAX_WIDTH kolona,
+ * a sve loptice i igraci moraju da stanu u listu sprajtova. Polozaji iz
+ * input.h pokrivaju celu visinu terena
+ */
+typedef char input_covers_field[INPUT_POSITIONS == 8 * OLED_BYTE_HEIGHT - PLANK_SIZE + 1 ? 1 : -1];
+typedef char sprite_fits_two_pages[(BALL_SIZE <= 9 && PLANK_SIZE <= 9) ? 1 : -1];
+typedef char sprite_width_fits[(BALL_SIZE <= SPRITE_MAX_WIDTH && PLANK_WIDTH <= SPRITE_MAX_WIDTH) ? 1 : -1];
+typedef char sprites_fit[(MAX_BALLS + 2 <= SPRITE_MAX) ? 1 : -1];
+
+/**
+ * Unapred pomerene maske loptice i igraca; racunaju se pri prevodjenju
+ * iz BALL_SIZE i PLANK_SIZE
  */
-static int xstep = DEF_X_STEP, ystep = 1;
+static const uint16_t ball_masks[8] = SHIFT_TABLE(BALL_MASK);
+static const uint16_t plank_masks[8] = SHIFT_TABLE(PLANK_MASK);
 
 /**
- * Trenutni frejm koji se iscrtava
+ * z vrednosti sprajtova. Loptice se iscrtavaju preko igraca, osim sa
+ * LATE_LATCH, kada se igraci iscrtavaju poslednji (Sprite_DrawRange);
+ * svi sprajtovi se iscrtavaju sa SPRITE_OR, pa je slika ista
  */
-uint8_t playground[OLED_WIDTH * OLED_BYTE_HEIGHT];
+#define BALL_Z 2
+#if LATE_LATCH
+#define BOARD_Z (BALL_Z + 1)
+#else
+#define BOARD_Z (BALL_Z - 1)
+#endif
+
+/**
+ * Sprajtovi loptica i igraca
+ */
+static Sprite ball_spr[MAX_BALLS];
+static Sprite board_spr[2] = {
+	{ .img = plank_masks, .cover = plank_masks, .width = PLANK_WIDTH,
+	  .mode = SPRITE_OR, .z = BOARD_Z, .visible = 1,
+	  .col = 1 },
+	{ .img = plank_masks, .cover = plank_masks, .width = PLANK_WIDTH,
+	  .mode = SPRITE_OR, .z = BOARD_Z, .visible = 1,
+	  .col = OLED_WIDTH - 1 - PLANK_WIDTH }
+};
+
+#if LATE_LATCH
+/**
+ * Funkcija koja daje polozaje igraca pri kasnom ocitavanju
+ */
+static void (*board_latch)(unsigned int *, unsigned int *) = 0;
+
+/**
+ * Polozaji igraca prosledjeni funkciji UpdateGame, za slucaj da
+ * funkcija za kasno ocitavanje nije zadata
+ */
+static unsigned int board_in[2];
+
+static void LatchBoards(unsigned int, unsigned int);
+#endif
+
+/**
+ * Indikator da su staticni sloj i sprajtovi pripremljeni (LoadBackground)
+ */
+static uint8_t scene_ready = 0;
+
+/**
+ * Polja rezultata: prvi igrac je poravnat uz desnu, a drugi uz levu
+ * stranu srednje linije
+ */
+static TextField score_field[2] = {
+	TEXT_FIELD(SCORE1_COL - TEXT_ADVANCE, 8 * SCORE1_ROW, 2, TEXT_RIGHT),
+	TEXT_FIELD(SCORE2_COL, 8 * SCORE2_ROW, 2, TEXT_LEFT)
+};
 
 /**
  * Koliko se jos ceka do generisanja nove loptice
@@ -111,24 +301,10 @@ static uint8_t new_ball = 1;
 static int i;
 
 /**
- * @brief Generator slucajnih brojeva
- *
- * Generator pseudoslucajnih brojeva koji radi na principu
- * Linearnog kongruentnog generatora:
- *
- * seed = (a * seed + c) % m;
- *
- * gde koeficijenti a, c i m moraju da zadovoljavaju odredjene uslove.
- * }
+ * Indikator da je UpdateGame odlucio da se frejm iscrtava, pa ga
+ * RenderFrame slaze, a FlushFrame salje
  */
-unsigned int random()
-{
-    static unsigned int nSeed = 5323;
-    nSeed = (8253729 * nSeed + 2396403);
-
-    return nSeed  % 32767;
-}
-
+static uint8_t frame_ready = 0;
 
 /**
  * @brief Funkcija koja osvezava ekran na prekid tajmera
@@ -148,297 +324,642 @@ unsigned int random()
  * i nasumicno odrediti na koju ce stranu da ide, kao i
  * koliki ce da bude korak po Y osi. Korak po X osi je
  * konstantan.
+ *
+ * Pre iscrtavanja se izvrsavaju svi koraci simulacije koji su se
+ * nakupili od prethodnog frejma (AdvanceClock), pa brzina igre ne zavisi
+ * od broja iscrtanih frejmova. Iscrtava se stanje posle poslednjeg koraka.
+ *
+ * Frejm se salje asinhrono, pa funkcija ne ceka da se slanje zavrsi
+ * i glavna petlja je slobodna do sledeceg prekida tajmera. Koriste se
+ * dva bafera: sledeci frejm se racuna i iscrtava u jedan dok se
+ * prethodni jos salje iz drugog, a ceka se tek pre slanja.
+ *
+ * Sa LATE_LATCH se igraci ocitavaju i iscrtavaju tek posle tog cekanja
+ * (LatchBoards), pa su na ekranu svezi koliko i frejm koji se salje.
+ *
+ * Funkcija se sastoji od tri dela (UpdateGame, RenderFrame, FlushFrame)
+ * koji se mogu izvrsavati i kao posebni zadaci rasporedjivaca (sched.h).
  */
 void RefreshScreen(unsigned int adc1, unsigned int adc2, uint8_t reset)
 {
-	// Sluzi za pravljenje pauze posle kraja igrice
-	if(idle_cnt>0){
-		idle_cnt--;
-	}
-	else
-	{
-		if(new_ball)
-		{
-			// Pozadina se ponovo ucitava
-			int i,j;
-			for(i = 0; i < OLED_BYTE_HEIGHT; i++)
-				for(j = 0; j < OLED_WIDTH; j++)
-					playground[i * OLED_WIDTH + j] = background[i * OLED_WIDTH + j];
+	UpdateGame(adc1, adc2);
+	RenderFrame();
+	FlushFrame();
+}
+
+/**
+ * @brief Koraci simulacije nakupljeni od prethodnog frejma
+ * @param Polozaj prvog igraca
+ * @param Polozaj drugog igraca
+ *
+ * Prvi deo funkcije RefreshScreen; posle nje se pozivaju RenderFrame i
+ * FlushFrame.
+ */
+void UpdateGame(unsigned int adc1, unsigned int adc2)
+{
+	// Frejm se iscrtava ako pauza nije trajala na pocetku frejma (da bi
+	// se prikazao novi rezultat) ili ako se zavrsila tokom frejma
+	uint8_t active = idle_cnt == 0;
 
-			xpos = OLED_WIDTH / 2;
+	TRACE(TRACE_FRAME_START, 0);
+	PROFILE_START();
+	HUD_FRAME_START();
 
-			//Nasumicna y koordinata lopte, izbegavamo preklapanje sa zidovima
-			unsigned int rnd = random();
-			ypos = (rnd | 0x3F) % (8 * OLED_BYTE_HEIGHT - (BALL_SIZE>>1)*2) + (BALL_SIZE>>1);
-			xstep = DEF_X_STEP * (rnd & 0x40 ? 1 : -1);
-			ystep = (rnd >> 7) % MAX_Y_STEP + 1;
+	while(pending_steps > 0)
+	{
+		pending_steps--;
 
-/*			if(reset)
-			{
-				score1 = score2 = 0;
-			}*/
-			new_ball = 0;
-		}
-		else
+		// Sluzi za pravljenje pauze posle kraja igrice
+		if(idle_cnt > 0)
 		{
-			// Ako nije reset, brisemo prethodne pozicije lopti
-			RemoveBall();
-			RemoveBoard();
-			RedrawMiddle();
+			idle_cnt--;
+			continue;
 		}
 
-		// Odredjujemo sledecu poziciju lopte, i rezultat
-		bpos1 = adc1; bpos2 = adc2;
+		if(new_ball)
+			ServeBall();
+
+		// Odredjujemo sledecu poziciju lopte, i rezultat. Sa LATE_LATCH
+		// se sudari racunaju sa polozajima igraca koji su prikazani u
+		// prethodnom frejmu (LatchBoards)
+#if !LATE_LATCH
+		SetBoards(adc1, adc2);
+#endif
 		NextState();
+	}
+	PROFILE_MARK(PROF_NEXTSTATE);
 
-		DrawBoard();
-		WriteResult();
-		DrawBall();
+	frame_ready = active || idle_cnt == 0;
+#if LATE_LATCH
+	board_in[0] = adc1;
+	board_in[1] = adc2;
+#endif
+}
 
-		//Slanje slike na OLED
-		OLED_PutPicture(playground);
+/**
+ * @brief Slaganje frejma pre cekanja na slanje prethodnog
+ *
+ * Drugi deo funkcije RefreshScreen. Ne radi nista ako se frejm ne
+ * iscrtava (pauza posle poena).
+ */
+void RenderFrame()
+{
+	if(!frame_ready)
+		return;
+
+	if(!scene_ready)
+	{
+		LoadBackground();
+		PROFILE_MARK(PROF_BACKGROUND);
 	}
+
+	// Rezultat i pokazatelji se upisuju u staticni sloj samo kada
+	// se promene
+	WriteResult();
+	HUD_UPDATE();
+	PROFILE_MARK(PROF_SCORE);
+
+#if RENDER_STREAM
+	// Strane se slazu tek pri slanju (FlushFrame)
+#if !LATE_LATCH
+	DrawBoard();
+#endif
+	DrawBall();
+#else
+	// Brisu se sprajtovi iscrtani u ovaj bafer i kopiraju promene
+	// staticnog sloja
+	Sprite_Erase(playground, back);
+	PROFILE_MARK(PROF_ERASE);
+
+#if LATE_LATCH
+	// Loptice se iscrtavaju unapred, a igraci tek kada se ocitaju
+	DrawBall();
+	Sprite_DrawRange(playground, back, 0, BALL_Z);
+#else
+	DrawBoard();
+	DrawBall();
+	Sprite_Draw(playground, back);
+#endif
+	PROFILE_MARK(PROF_DRAW);
+#endif
 }
 
 /**
- * @brief Iscrtavanje igraca
+ * @brief Cekanje na prethodni frejm i slanje novog
  *
- * Iscrtava oba igraca na osnovu vrednosti koje su prosledjene funkciji
- * RefreshScreen i koje predstavljaju skalirane vrednosti AD konvertora.
- * Igraci se iscrtavaju tako sto se odredjeni biti u matrici koja predstavlja
- * trenutni frejm postavljaju na 1.
+ * Treci deo funkcije RefreshScreen. Kopija poslednje slike u drajveru
+ * se menja tek kada se prethodni frejm posalje, pa se ceka pre slanja.
  */
-void DrawBoard()
+void FlushFrame()
 {
-	int pos1 = bpos1, pos2 = bpos2;
-	int row = pos1 / 8, offs = pos1 % 8;
-	playground[row * OLED_WIDTH + 1] |= 0xFF << offs;
-	playground[row * OLED_WIDTH + 2] |= 0xFF << offs;
-	playground[(row + 1)* OLED_WIDTH + 1] |= 0xFF >> (8 - offs);
-	playground[(row + 1)* OLED_WIDTH + 2] |= 0xFF >> (8 - offs);
-
-	row = pos2 / 8, offs = pos2 % 8;
-	playground[row * OLED_WIDTH + (OLED_WIDTH - 2)] |= 0xFF << offs;
-	playground[row * OLED_WIDTH + (OLED_WIDTH - 3)] |= 0xFF << offs;
-	playground[(row + 1)* OLED_WIDTH + (OLED_WIDTH - 2)] |= 0xFF >> (8 - offs);
-	playground[(row + 1)* OLED_WIDTH + (OLED_WIDTH - 3)] |= 0xFF >> (8 - offs);
+	if(frame_ready)
+	{
+		frame_ready = 0;
+
+		// Prethodni frejm se mozda jos salje
+		OLED_WaitIdle();
+		PROFILE_MARK(PROF_WAIT);
+
+#if RENDER_STREAM
+#if LATE_LATCH
+		LatchBoards(board_in[0], board_in[1]);
+#endif
+		// Svaka strana se iscrtava i salje pre iscrtavanja sledece, dok
+		// se prethodne strane jos salju
+		for(i = 0; i < OLED_BYTE_HEIGHT; i++)
+		{
+			Sprite_RenderPage(pagebuf.b, i);
+			OLED_PutPageDiff(i, pagebuf.b);
+		}
+		PROFILE_MARK(PROF_SEND);
+		PROFILE_END();
+		HUD_FRAME_END(OLED_FrameBytes());
+#else
+#if LATE_LATCH
+		LatchBoards(board_in[0], board_in[1]);
+		Sprite_DrawRange(playground, back, BALL_Z + 1, 0xFF);
+		PROFILE_MARK(PROF_DRAW);
+#endif
+
+		//Slanje promenjenih delova slike na OLED
+		OLED_PutPictureDiff(playground);
+		PROFILE_MARK(PROF_SEND);
+		PROFILE_END();
+		HUD_FRAME_END(OLED_FrameBytes());
+
+		// Bafer koji se salje ne sme da se menja, pa se sledeci frejm
+		// iscrtava u drugi bafer
+		back ^= 1;
+		playground = framebuf[back].b;
+#endif
+	}
+
+	TRACE(TRACE_FRAME_END, 0);
 }
 
 /**
- * @brief Ponovno iscrtavanje sredista terena
+ * @brief Napredovanje vremena simulacije
+ * @param Broj prekida tajmera od prethodnog poziva
  *
- * Cilj ove funkcije je da ponovo iscrta isprekidanu liniju na sredini
- * terena za slucaj da je funkcija RemoveBall izbrisala neki njen deo
- * dok je brisala lopticu.
+ * Koraci simulacije se izvrsavaju u sledecem pozivu RefreshScreen
+ * (UpdateGame).
  */
-void RedrawMiddle()
+void AdvanceClock(unsigned int ticks)
 {
-	for(i = 0; i < OLED_BYTE_HEIGHT; i++)
+	pending_steps += ticks * PHYS_STEPS_PER_TICK;
+	if(pending_steps > PHYS_MAX_STEPS)
+		pending_steps = PHYS_MAX_STEPS;
+}
+
+/**
+ * @brief Vracanje igre u pocetno stanje
+ *
+ * Brisu se rezultati i zahteva se nova loptica. Generator slucajnih
+ * brojeva se ne dira; za isti tok igre posle poziva treba postaviti i
+ * njegovo stanje (Prng_Seed).
+ */
+void InitGame()
+{
+	score1 = score2 = 0;
+	bpos1 = bpos2 = 15;
+	balls = 0;
+	rally = 0;
+	next_spawn = MULTIBALL_RALLY;
+	pending_steps = 0;
+	idle_cnt = 0;
+	new_ball = 1;
+	scene_ready = 0;
+	frame_ready = 0;
+}
+
+/**
+ * @brief Generisanje nove loptice
+ *
+ * Sve loptice se uklanjaju i servira se jedna nova.
+ */
+void ServeBall()
+{
+	balls = 0;
+	rally = 0;
+	next_spawn = MULTIBALL_RALLY;
+	SpawnBall();
+	new_ball = 0;
+}
+
+/**
+ * @brief Dodavanje loptice
+ *
+ * Loptica se postavlja na sredinu terena, na nasumicnu visinu, i
+ * nasumicno se odredjuje na koju ce stranu da ide i koliki ce da bude
+ * korak po Y osi. Ako vec ima MAX_BALLS loptica, nova se ne dodaje.
+ */
+void SpawnBall()
+{
+	uint8_t k = balls;
+
+	if(k >= MAX_BALLS)
+		return;
+
+	xpos[k] = OLED_WIDTH / 2;
+
+	//Nasumicna y koordinata lopte, izbegavamo preklapanje sa zidovima
+	ypos[k] = Prng_Range(8 * OLED_BYTE_HEIGHT - (BALL_SIZE>>1)*2) + (BALL_SIZE>>1);
+	xstep[k] = STEP_TO_FIX(DEF_X_STEP) * (Prng_Next() & 0x8000 ? 1 : -1);
+	ystep[k] = STEP_TO_FIX(Prng_Range(MAX_Y_STEP) + 1);
+	fxpos[k] = TO_FIX(xpos[k]);
+	fypos[k] = TO_FIX(ypos[k]);
+
+	balls = k + 1;
+	TRACE(TRACE_BALL_SPAWN, ypos[k]);
+}
+
+/**
+ * @brief Ukljucivanje i iskljucivanje rezima sa vise loptica
+ * @param 1 - nove loptice se dodaju tokom duzih poena, 0 - jedna loptica
+ */
+void SetMultiBall(uint8_t on)
+{
+	multiball = on;
+}
+
+/**
+ * @brief Postavljanje polozaja igraca
+ * @param Polozaj prvog igraca
+ * @param Polozaj drugog igraca
+ */
+void SetBoards(int pos1, int pos2)
+{
+	bpos1 = pos1;
+	bpos2 = pos2;
+}
+
+#if LATE_LATCH
+/**
+ * @brief Postavljanje funkcije koja daje polozaje igraca pri kasnom
+ * ocitavanju
+ * @param Funkcija koja upisuje polozaje prvog i drugog igraca, ili 0 da
+ * bi se koristili polozaji prosledjeni funkciji RefreshScreen
+ */
+void SetBoardLatch(void (*latch)(unsigned int *, unsigned int *))
+{
+	board_latch = latch;
+}
+
+/**
+ * @brief Kasno ocitavanje polozaja igraca
+ * @param Polozaj prvog igraca prosledjen funkciji RefreshScreen
+ * @param Polozaj drugog igraca prosledjen funkciji RefreshScreen
+ *
+ * Poziva se posle cekanja na slanje prethodnog frejma, neposredno pre
+ * slanja. Ocitani polozaji se prikazuju u ovom frejmu i koriste za
+ * sudare u sledecem, pa se loptica odbija od igraca koji je bio na
+ * ekranu.
+ */
+static void LatchBoards(unsigned int pos1, unsigned int pos2)
+{
+	if(board_latch)
+		board_latch(&pos1, &pos2);
+	SetBoards(pos1, pos2);
+	DrawBoard();
+}
+#endif
+
+/**
+ * @brief Ocitavanje polozaja prve loptice
+ * @param Adresa na koju se upisuje X koordinata
+ * @param Adresa na koju se upisuje Y koordinata
+ */
+void GetBall(int *x, int *y)
+{
+	*x = xpos[0];
+	*y = ypos[0];
+}
+
+/**
+ * @brief Broj loptica u igri
+ */
+uint8_t GetBallCount()
+{
+	return balls;
+}
+
+/**
+ * @brief Poslednji frejm poslat na OLED
+ * @return Bafer koji se salje ili je poslednji poslat
+ */
+const uint8_t *GetDisplayedFrame()
+{
+#if RENDER_STREAM
+	return OLED_LastPicture();
+#else
+	return framebuf[back ^ 1].b;
+#endif
+}
+
+/**
+ * @brief Ucitavanje pozadine
+ *
+ * Staticni sloj se puni pozadinom terena i u njega se dodaju sprajtovi
+ * loptice i igraca. Oba bafera se pri sledecem iscrtavanju cela
+ * prepisuju staticnim slojem, a rezultat se ponovo ispisuje.
+ */
+void LoadBackground()
+{
+	Sprite_Init(background);
+	Sprite_Add(&board_spr[0]);
+	Sprite_Add(&board_spr[1]);
+	for(i = 0; i < MAX_BALLS; i++)
 	{
-		playground[i * OLED_WIDTH + (OLED_WIDTH>>1)] |= background[i * OLED_WIDTH + (OLED_WIDTH>>1)];
-		playground[i * OLED_WIDTH + (OLED_WIDTH>>1) - 1] |= background[i * OLED_WIDTH + (OLED_WIDTH>>1) - 1];
+		ball_spr[i].img = ball_spr[i].cover = ball_masks;
+		ball_spr[i].width = BALL_SIZE;
+		ball_spr[i].mode = SPRITE_OR;
+		ball_spr[i].z = BALL_Z;
+		ball_spr[i].visible = 0;
+		Sprite_Add(&ball_spr[i]);
 	}
+	Text_Invalidate(&score_field[0]);
+	Text_Invalidate(&score_field[1]);
+	HUD_INVALIDATE();
+	scene_ready = 1;
 }
 
 /**
- * @brief Brisanje igraca
+ * @brief Iscrtavanje igraca
  *
- * Brisanje oba igraca postavljanjem vrednosti odredjenih bita u
- * matrici trenutnog frejma na 0.
+ * Postavlja polozaje sprajtova oba igraca na osnovu vrednosti koje su
+ * prosledjene funkciji UpdateGame (Input_Paddle, 0 - INPUT_POSITIONS-1).
+ * Sprajtovi se iscrtavaju u Sprite_Draw.
  */
-void RemoveBoard()
+void DrawBoard()
 {
-	int pos1 = bpos1, pos2 = bpos2;
-	int row = pos1 / 8, offs = pos1 % 8;
-	playground[row * OLED_WIDTH + 1] &= ~( 0xFF << offs );
-	playground[row * OLED_WIDTH + 2] &= ~( 0xFF << offs) ;
-	playground[(row + 1)* OLED_WIDTH + 1] &= ~( 0xFF >> (8 - offs) );
-	playground[(row + 1)* OLED_WIDTH + 2] &= ~( 0xFF >> (8 - offs) );
-
-	row = pos2 / 8, offs = pos2 % 8;
-	playground[row * OLED_WIDTH + (OLED_WIDTH - 2)] &= ~( 0xFF << offs );
-	playground[row * OLED_WIDTH + (OLED_WIDTH - 3)] &= ~( 0xFF << offs );
-	playground[(row + 1)* OLED_WIDTH + (OLED_WIDTH - 2)] &= ~( 0xFF >> (8 - offs) );
-	playground[(row + 1)* OLED_WIDTH + (OLED_WIDTH - 3)] &= ~( 0xFF >> (8 - offs) );
+	board_spr[0].top = bpos1;
+	board_spr[1].top = bpos2;
 }
 
 /**
- * @brief Iscrtavanje loptice
+ * @brief Iscrtavanje loptica
  *
- * Loptica se iscrtava na osnovu trenutne pozicije loptice dobijene
- * iz funkcije NextState. Iscrtava se tako sto se odredjeni biti u
- * matrici trenutnog frejma postavljaju na 1.
+ * Postavlja polozaje sprajtova loptica na trenutne pozicije dobijene iz
+ * funkcije NextState; sprajtovi neaktivnih loptica se sakrivaju.
+ * Sprajtovi se iscrtavaju u Sprite_Draw.
  */
 void DrawBall()
 {
-	int row = ypos / 8, offs = ypos % 8;
-	for(i = xpos - (BALL_SIZE>>1); i <= xpos + (BALL_SIZE>>1); i++)
+	uint8_t k;
+	for(k = 0; k < balls; k++)
 	{
-	    int shift = offs-(BALL_SIZE>>1);
-		playground[row * OLED_WIDTH + i] |= shift > 0 ? BALL_MASK << shift : BALL_MASK >> (-shift);
-		if(offs < (BALL_SIZE>>1))
-		{
-			playground[(row - 1) * OLED_WIDTH + i] |= BALL_MASK << offs + 8 - (BALL_SIZE>>1);
-		}
-		else if(7 - offs < (BALL_SIZE>>1))
-		{
-			playground[(row + 1) * OLED_WIDTH + i] |= BALL_MASK >> BALL_SIZE - (offs + (BALL_SIZE>>1) - 7);
-		}
+		ball_spr[k].col = xpos[k] - (BALL_SIZE>>1);
+		ball_spr[k].top = ypos[k] - (BALL_SIZE>>1);
+		ball_spr[k].visible = 1;
 	}
+	for(; k < MAX_BALLS; k++)
+		ball_spr[k].visible = 0;
 }
 
 /**
- * @brief Brisanje loptice
+ * @brief Slaganje trenutnog frejma
  *
- * Loptica sebrise na osnovu prethodne pozicije. Brise se tako sto se odredjeni biti u
- * matrici trenutnog frejma postavljaju na 0.
+ * Brisu se sprajtovi iscrtani u bafer, kopiraju se promene staticnog
+ * sloja i sprajtovi se iscrtavaju na novim polozajima. Bez bafera
+ * frejma (RENDER_STREAM) strane se samo iscrtavaju, bez slanja.
  */
-void RemoveBall()
+void ComposeFrame()
 {
-	int row = ypos / 8, offs = ypos % 8;
-	for(i = xpos - (BALL_SIZE>>1); i <= xpos + (BALL_SIZE>>1); i++)
-	{
-	    int shift = offs-(BALL_SIZE>>1);
-		playground[row * OLED_WIDTH + i] &= ~( (shift > 0) ? (BALL_MASK << shift) : (BALL_MASK >> (-shift)) );
-		if(offs < (BALL_SIZE>>1))
-		{
-			playground[(row - 1) * OLED_WIDTH + i] &= ~( BALL_MASK << offs + 8 - (BALL_SIZE>>1) );
-		}
-		else if(7 - offs < (BALL_SIZE>>1))
-		{
-			playground[(row + 1) * OLED_WIDTH + i] &= ~( BALL_MASK >> BALL_SIZE - (offs + (BALL_SIZE>>1) - 7) );
-		}
-	}
+#if RENDER_STREAM
+	for(i = 0; i < OLED_BYTE_HEIGHT; i++)
+		Sprite_RenderPage(pagebuf.b, i);
+#else
+	Sprite_Erase(playground, back);
+	Sprite_Draw(playground, back);
+#endif
 }
 
+#if !RENDER_STREAM
+/**
+ * @brief Iscrtavanje sprajtova loptica ili igraca u bafer koji se slaze
+ * @param 1 - loptice, 0 - igraci
+ *
+ * Deo funkcije ComposeFrame, posebno za merenje brzine (bench.c).
+ */
+void DrawSprites(uint8_t ball)
+{
+	uint8_t z = ball ? BALL_Z : BOARD_Z;
+	Sprite_DrawRange(playground, back, z, z);
+}
+
+/**
+ * @brief Brisanje svih sprajtova iz bafera koji se slaze
+ *
+ * Deo funkcije ComposeFrame, posebno za merenje brzine (bench.c).
+ */
+void EraseSprites()
+{
+	Sprite_Erase(playground, back);
+}
+#endif
+
 /**
  * @brief Ispisivanje rezultata
  *
- * Rezultat se ispisuje koristeci Look-up tabelu datu u fajlu lut.h.
- * Look-up tabela sadrzi podatke potrebne za ispisivanje cifara na
- * OLED displej.
+ * Rezultat se upisuje u staticni sloj (text.h), i to samo polje koje
+ * se promenilo, a kopira se samo promenjeni deo polja.
  */
 void WriteResult()
 {
-	if(score1 < 10)
+	uint8_t *layer = Sprite_StaticLayer();
+	unsigned int score[2];
+	TextSpan span;
+	uint8_t p, f;
+
+	// Prikazuju se dve poslednje cifre rezultata
+	score[0] = ARITH_MOD(score1, 100);
+	score[1] = ARITH_MOD(score2, 100);
+	for(f = 0; f < 2; f++)
 	{
-		for(i = 0; i < NUM_OF_COLS; i++)
-		{
-			playground[SCORE1_ROW * OLED_WIDTH + SCORE1_COL + i] = lut[score1 * NUM_OF_COLS + i];
-		}
+		if(!Text_Number(&score_field[f], score[f], layer, &span))
+			continue;
+		for(p = span.page; p < span.page + span.pages; p++)
+			Sprite_StaticChanged(p * OLED_WIDTH + span.col, span.len);
 	}
-	else
+}
+
+/**
+ * @brief Odbijanje od gornjeg i donjeg zida
+ * @param Y koordinata (Q8.8) bez uzimanja zidova u obzir
+ * @param Indeks loptice
+ * @return Y koordinata posle odbijanja
+ *
+ * Koordinata se preslikava u odnosu na zid sve dok ne bude izmedju
+ * zidova, pa je odbijanje tacno i kada loptica u jednom koraku udari
+ * u oba zida. Svako odbijanje menja znak brzine po Y osi.
+ */
+static int ReflectY(int y, uint8_t k)
+{
+	while(y > Y_MAX || y < Y_MIN)
 	{
-		for(i = 0; i < NUM_OF_COLS; i++)
-		{
-			playground[SCORE1_ROW * OLED_WIDTH + SCORE1_COL + i - NUM_OFFSET] = lut[((score1 % 100)/10) * NUM_OF_COLS + i];
-			playground[SCORE1_ROW * OLED_WIDTH + SCORE1_COL + i] = lut[score1 % 10 * NUM_OF_COLS + i];
-		}
+		y = y > Y_MAX ? 2*Y_MAX - y : 2*Y_MIN - y;
+		ystep[k] = -ystep[k];
 	}
+	return y;
+}
 
-	if(score2 < 10){
-		for(i = 0; i < NUM_OF_COLS; i++)
-		{
-			playground[SCORE2_ROW * OLED_WIDTH + SCORE2_COL + i] = lut[score2 * NUM_OF_COLS + i];
-		}
-	}
+/**
+ * @brief Udarac u igraca
+ * @param Polozaj igraca
+ * @param Indeks loptice
+ * @return 1 ako je igrac odbio lopticu
+ *
+ * Na osnovu rastojanja loptice od centra daske odredjuje se nova brzina
+ * po Y osi, a brzina po X osi menja smer i povecava se za RALLY_SPEEDUP.
+ */
+static uint8_t HitBoard(int bpos, uint8_t k)
+{
+	// Odredjivanje rastojanja loptice od centra daske
+	int dist = bpos - ypos[k] + (PLANK_SIZE>>1);
+	int vx = xstep[k];
+	dist = dist > 0 ? dist : dist - 1;
+
+	//Nije pogodjena daska
+	if(ARITH_ABS(dist) > (PLANK_SIZE>>1) + (BALL_SIZE>>1) + 1)
+		return 0;
+
+	vx = vx > 0 ? -vx - RALLY_SPEEDUP : -vx + RALLY_SPEEDUP;
+	if(vx > MAX_X_SPEED)
+		vx = MAX_X_SPEED;
+	else if(vx < -MAX_X_SPEED)
+		vx = -MAX_X_SPEED;
+	xstep[k] = vx;
+
+	if(ARITH_ABS(dist) > MAX_Y_STEP)
+		ystep[k] = STEP_TO_FIX(dist > 0 ? -MAX_Y_STEP : MAX_Y_STEP);
 	else
-	{
-		for(i = 0; i < NUM_OF_COLS; i++)
-		{
-			playground[SCORE2_ROW * OLED_WIDTH + SCORE2_COL + i] = lut[((score2 % 100)/10) * NUM_OF_COLS + i];
-			playground[SCORE2_ROW * OLED_WIDTH + SCORE2_COL + i + NUM_OFFSET] = lut[score2 % 10 * NUM_OF_COLS + i];
-		}
-	}
+		ystep[k] = STEP_TO_FIX(-dist);
+	return 1;
 }
 
 /**
- * @brief Odredjivanje sledeceg polozaja loptice
+ * @brief Jedan korak simulacije za jednu lopticu
+ * @param Indeks loptice
+ * @return 0 ako je loptica prosla pored igraca, 1 inace
  *
- * Funkcija odredjuje sledeci polozaj loptice na osnovu njenog
- * trenutnog polozaja i vrednosti koraka po X i Y osi. Ako je
- * loptica blizu gornjeg ili donjeg zida potrebno je azurirati
- * novu poziciju tako da izgleda kao da se loptica odbila. U
- * tom slucaju se menja i vrednost koraka po Y osi.
+ * Loptica se pomera (Q8.8) za svoju brzinu po X i Y osi, pri cemu se
+ * sudari racunaju neprekidno, pa loptica ne moze da "preskoci" igraca
+ * ni pri velikim brzinama.
  *
- * Takodje je potrebno odrediti da li je igrac sprecio lopticu
- * da prodje, i da li je osvojio poen. Takodje, vrse se azuriranja
- * koraka po X i Y osi ako je loptica udarila u igraca. Ako je igrac
- * izgubio poen, signalizira se da je potrebno generisati novu lopticu.
+ * Ako bi loptica u ovom koraku presla ravan igraca, racuna se trenutak
+ * dodira (jedino deljenje u funkciji, samo kada do dodira dodje) i
+ * polozaj po Y osi u tom trenutku. Ako je igrac sprecio lopticu da
+ * prodje, loptica se odbija i nastavlja kretanje do kraja koraka novom
+ * brzinom; u suprotnom protivnik osvaja poen. Odbijanja od gornjeg i
+ * donjeg zida racuna funkcija ReflectY.
  */
-void NextState()
+static uint8_t StepBall(uint8_t k)
 {
-// Azuriranje X koordinate
-	// Ako ce loptica udariti u desni zid
-	if(xpos + xstep >= (OLED_WIDTH - (BALL_SIZE>>1)) - 2)
+	int t = FIX_ONE;	// preostali deo koraka
+	int fx = fxpos[k], fy = fypos[k];
+	int dx, dy, plane, tc;
+	uint8_t n, alive = 1;
+
+	HAL_COST(SIM_COST_BALL_STEP);
+	for(n = 0; n < MAX_BOUNCES && t > 0; n++)
 	{
-		// Odredjivanje rastojanja loptice od centra daske
-		//int dist =  bpos1 - (8*OLED_BYTE_HEIGHT - (PLANK_SIZE>>1));
-		int dist =  bpos2 - ypos + (PLANK_SIZE>>1);
-		//score2 = dist;
-		dist = dist > 0 ? dist : dist - 1;
-
-		//Nije pogodjena daska
-		if(abs(dist) > (PLANK_SIZE>>1) + (BALL_SIZE>>1) + 1)
+		dx = (int)(((long)xstep[k] * t) >> FIX_SHIFT);
+		dy = (int)(((long)ystep[k] * t) >> FIX_SHIFT);
+
+		if(fx + dx > X_MAX)
+			plane = X_MAX;
+		else if(fx + dx < X_MIN)
+			plane = X_MIN;
+		else
 		{
-			idle_cnt = IDLE_WAIT;
-			new_ball = 1;
-			score1++;
+			// Loptica ne dolazi do igraca u ovom koraku
+			fx += dx;
+			fy = ReflectY(fy + dy, k);
+			break;
 		}
-		else
+
+		// Trenutak dodira sa ravni igraca, kao deo koraka. Rastojanje do
+		// ravni i brzina imaju isti znak, a rastojanje nije vece od brzine.
+		HAL_COST(SIM_COST_BOUNCE);
+		tc = xstep[k] > 0 ? Arith_Frac(plane - fx, xstep[k], FIX_SHIFT)
+				: Arith_Frac(fx - plane, -xstep[k], FIX_SHIFT);
+		fx = plane;
+		fy = ReflectY(fy + (int)(((long)ystep[k] * tc) >> FIX_SHIFT), k);
+		ypos[k] = FROM_FIX(fy);
+		t -= tc;
+
+		if(!HitBoard(plane == X_MAX ? bpos2 : bpos1, k))
 		{
-			xstep = -xstep;
-			if(abs(dist) > MAX_Y_STEP)
-				ystep = dist > 0 ? -MAX_Y_STEP : MAX_Y_STEP;
+			if(plane == X_MAX)
+			{
+				score1++;
+				TRACE(TRACE_SCORE, 1);
+			}
 			else
-				ystep = -dist;
+			{
+				score2++;
+				TRACE(TRACE_SCORE, 2);
+			}
+			alive = 0;
+			break;
 		}
+		rally++;
 	}
-	// Ako ce udariti u levi zid
-	else if(xpos + xstep < (BALL_SIZE>>1) + 2 )
-	{
-		// Odredjivanje rastojanja loptice od centra daske
-		//int dist =  bpos1 - (8*OLED_BYTE_HEIGHT - (PLANK_SIZE>>1));
-		int dist =  bpos1 - ypos + (PLANK_SIZE>>1);
-		dist = dist > 0 ? dist : dist - 1;
 
-		//Nije pogodjena daska
-		if(abs(dist) > (PLANK_SIZE>>1) + (BALL_SIZE>>1) + 1)
+	fxpos[k] = fx;
+	fypos[k] = fy;
+
+	// Polozaj u pikselima koji se iscrtava
+	xpos[k] = FROM_FIX(fx);
+	ypos[k] = FROM_FIX(fy);
+	return alive;
+}
+
+/**
+ * @brief Odredjivanje sledeceg polozaja loptica
+ *
+ * Funkcija izvrsava jedan korak simulacije za sve loptice redom.
+ * Loptice koje su prosle pored igraca se uklanjaju (na njihovo mesto u
+ * nizovima dolazi poslednja loptica), osim poslednje: ona ostaje na
+ * mestu dok traje pauza, i signalizira se da je potrebno generisati
+ * novu lopticu. U rezimu sa vise loptica, posle svakih MULTIBALL_RALLY
+ * odbijanja dodaje se nova loptica.
+ */
+void NextState()
+{
+	uint8_t k = 0;
+
+	while(k < balls)
+	{
+		if(StepBall(k))
 		{
-			idle_cnt = IDLE_WAIT;
-			new_ball = 1;
-			score2++;
+			k++;
+			continue;
 		}
-		else
+
+		if(balls == 1)
 		{
-			xstep = -xstep;
-			if(abs(dist) > MAX_Y_STEP)
-				ystep = dist > 0 ? -MAX_Y_STEP : MAX_Y_STEP;
-			else
-				ystep = -dist;
+			idle_cnt = IDLE_WAIT * PHYS_STEPS_PER_TICK;
+			new_ball = 1;
+			break;
 		}
-	}
-	else
-	{
-		xpos += xstep;
-	}
 
-// Azuriranje Y koordinate
-	// Ako ce loptica udariti u donji zid
-	if(ypos + ystep >= (8*OLED_BYTE_HEIGHT - (BALL_SIZE>>1)))
-	{
-		ypos = 2*(8*OLED_BYTE_HEIGHT - 1) - (ypos + ystep);
-		ystep = -ystep;
-	}
-	// Ako ce udariti u gornji zid
-	else if(ypos + ystep < (BALL_SIZE>>1) )
-	{
-		ypos  = -(ypos + ystep);
-		ystep = -ystep;
+		// Poslednja loptica, koja jos nije pomerena u ovom koraku,
+		// prelazi na mesto izgubljene
+		balls--;
+		xpos[k] = xpos[balls];
+		ypos[k] = ypos[balls];
+		fxpos[k] = fxpos[balls];
+		fypos[k] = fypos[balls];
+		xstep[k] = xstep[balls];
+		ystep[k] = ystep[balls];
 	}
-	else
+
+	if(rally >= next_spawn)
 	{
-		ypos += ystep;
+		while(rally >= next_spawn)
+			next_spawn += MULTIBALL_RALLY;
+		if(multiball && !new_ball)
+			SpawnBall();
 	}
-
 }
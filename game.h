@@ -14,6 +14,39 @@
  */
 #define MAX_ADC_VAL 4095
 
+/**
+ * Nacin iscrtavanja: 0 - dva bafera frejma i slanje promena,
+ * 1 - strana po strana, bez bafera frejma (stedi 2 x IMAGE_SIZE bajtova RAM-a)
+ */
+#ifndef RENDER_STREAM
+#define RENDER_STREAM 0
+#endif
+
+/**
+ * Najveci broj loptica u igri
+ */
+#ifndef MAX_BALLS
+#define MAX_BALLS 4
+#endif
+
+/**
+ * Rezim sa vise loptica na pocetku (moze se promeniti pozivom
+ * SetMultiBall)
+ */
+#ifndef MULTIBALL_ENABLE
+#define MULTIBALL_ENABLE 0
+#endif
+
+/**
+ * Kasno ocitavanje igraca: 0 - polozaji igraca se zadaju pri pozivu
+ * RefreshScreen, 1 - staticni sloj i loptice se slazu pre cekanja na
+ * slanje prethodnog frejma, a polozaji igraca se citaju (SetBoardLatch)
+ * tek posle cekanja, neposredno pre slanja
+ */
+#ifndef LATE_LATCH
+#define LATE_LATCH 0
+#endif
+
 /**
  * @brief Funkcija koja osvezava ekran na prekid tajmera
  * @param Polozaj prvog igraca
@@ -21,39 +54,129 @@
  */
 void RefreshScreen(unsigned int adc1, unsigned int adc2, uint8_t reset);
 
+/**
+ * @brief Koraci simulacije nakupljeni od prethodnog frejma (prvi deo
+ * RefreshScreen)
+ * @param Polozaj prvog igraca
+ * @param Polozaj drugog igraca
+ */
+void UpdateGame(unsigned int, unsigned int);
+
+/**
+ * @brief Slaganje frejma pre cekanja na slanje prethodnog (drugi deo
+ * RefreshScreen)
+ */
+void RenderFrame();
+
+/**
+ * @brief Cekanje na prethodni frejm i slanje novog (treci deo
+ * RefreshScreen)
+ */
+void FlushFrame();
+
+/**
+ * @brief Napredovanje vremena simulacije
+ * @param Broj prekida tajmera od prethodnog poziva
+ */
+void AdvanceClock(unsigned int);
+
+/**
+ * @brief Vracanje igre u pocetno stanje
+ */
+void InitGame();
+
+/**
+ * @brief Generisanje nove loptice
+ */
+void ServeBall();
+
+/**
+ * @brief Dodavanje loptice
+ */
+void SpawnBall();
+
+/**
+ * @brief Ukljucivanje i iskljucivanje rezima sa vise loptica
+ * @param 1 - nove loptice se dodaju tokom duzih poena, 0 - jedna loptica
+ */
+void SetMultiBall(uint8_t);
+
+/**
+ * @brief Postavljanje polozaja igraca
+ * @param Polozaj prvog igraca
+ * @param Polozaj drugog igraca
+ */
+void SetBoards(int, int);
+
+#if LATE_LATCH
+/**
+ * @brief Postavljanje funkcije koja daje polozaje igraca pri kasnom
+ * ocitavanju
+ * @param Funkcija koja upisuje polozaje prvog i drugog igraca, ili 0 da
+ * bi se koristili polozaji prosledjeni funkciji RefreshScreen
+ */
+void SetBoardLatch(void (*)(unsigned int *, unsigned int *));
+#endif
+
+/**
+ * @brief Ocitavanje polozaja prve loptice
+ * @param Adresa na koju se upisuje X koordinata
+ * @param Adresa na koju se upisuje Y koordinata
+ */
+void GetBall(int *, int *);
+
+/**
+ * @brief Broj loptica u igri
+ */
+uint8_t GetBallCount();
+
+/**
+ * @brief Poslednji frejm poslat na OLED
+ */
+const uint8_t *GetDisplayedFrame();
+
+/**
+ * @brief Ucitavanje pozadine
+ */
+void LoadBackground();
+
 /**
  * @brief Iscrtavanje igraca
  */
 void DrawBoard();
 
 /**
- * @brief Brisanje igraca
+ * @brief Iscrtavanje loptica
  */
-void RemoveBoard();
+void DrawBall();
 
 /**
- * @brief Iscrtavanje loptice
+ * @brief Slaganje trenutnog frejma
  */
-void DrawBall();
+void ComposeFrame();
 
+#if !RENDER_STREAM
 /**
- * @brief  Brisanje loptice
+ * @brief Iscrtavanje sprajtova loptica (1) ili igraca (0) u bafer koji
+ * se slaze, bez brisanja (za merenje brzine)
  */
-void RemoveBall();
+void DrawSprites(uint8_t);
 
 /**
- * @brief Ispisivanje rezultata
+ * @brief Brisanje svih sprajtova iz bafera koji se slaze (za merenje
+ * brzine)
  */
-void WriteResult();
+void EraseSprites();
+#endif
 
 /**
- * @brief Odredjivanje sledeceg polozaja loptice
+ * @brief Ispisivanje rezultata
  */
-void NextState();
+void WriteResult();
 
 /**
- * @brief Ponovno iscrtavanje sredista terena
+ * @brief Jedan korak simulacije: sledeci polozaj loptica
  */
-void RedrawMiddle();
+void NextState();
 
 #endif /* GAME_H_ */
@@ -0,0 +1,134 @@
+/**
+ * @file hal.h
+ * @brief Sloj za apstrakciju hardvera koji koriste igrica i drajver za OLED
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Igrica (game.c) i drajver za OLED (oled.c) pristupaju periferijama
+ * iskljucivo preko ovog sloja, pa se mogu prevesti i za mikrokontroler
+ * MSP430F5438A i za Linux na racunaru. Operacije nad SPI magistralom i
+ * pinovima su makroi koje definise odabrana implementacija, da na
+ * mikrokontroleru ne bi bilo dodatnih poziva funkcija.
+ *
+ * Svaka implementacija definise sledece makroe:
+ *  - HAL_CS_HIGH(), HAL_CS_LOW()     CS signal OLED-a
+ *  - HAL_DC_HIGH(), HAL_DC_LOW()     DC signal OLED-a
+ *  - HAL_RST_HIGH(), HAL_RST_LOW()   RST signal OLED-a
+ *  - HAL_SPI_WRITE(b)                upis bajta u predajni registar SPI
+ *  - HAL_SPI_TX_READY()              predajni registar je slobodan
+ *  - HAL_SPI_BUSY()                  SPI jos salje
+ *  - HAL_DELAY_CYCLES(n)             kasnjenje od n taktova
+ *  - HAL_COST(n)                     procenjeno trajanje dela programa u
+ *                                    taktovima; napreduje simulirano
+ *                                    vreme na racunaru, a na
+ *                                    mikrokontroleru ne radi nista
+ *  - HAL_TIMESTAMP()                 16-bitni slobodni brojac vremena
+ *  - HAL_TIMER_COUNT()               brojac tajmera koji generise prekide
+ *  - HAL_IRQ_SAVE(s), HAL_IRQ_RESTORE(s)  zabrana i vracanje prekida
+ *  - HAL_SLEEP()                     cekanje prekida tajmera u rezimu
+ *                                    male potrosnje, poziva se sa
+ *                                    zabranjenim prekidima
+ */
+#ifndef HAL_H_
+#define HAL_H_
+
+#include <stdint.h>
+
+#ifdef __MSP430__
+#include "hal_msp430.h"
+#else
+#include "host/hal_linux.h"
+#endif
+
+/**
+ * Maksimalna vrednost koju AD konvertor moze da generise
+ */
+#define HAL_ADC_MAX 4095
+
+/**
+ * Svaki potenciometar se konvertuje 2^HAL_ADC_OVERSAMPLE_SHIFT puta u
+ * jednoj sekvenci, a HAL_ReadPaddle vraca srednju vrednost. Sekvenca
+ * ima 2 x HAL_ADC_OVERSAMPLE konverzija i staje u 16 memorijskih
+ * lokacija AD konvertora, pa je najveci pomeraj 3
+ */
+#ifndef HAL_ADC_OVERSAMPLE_SHIFT
+#define HAL_ADC_OVERSAMPLE_SHIFT 2
+#endif
+#define HAL_ADC_OVERSAMPLE (1 << HAL_ADC_OVERSAMPLE_SHIFT)
+
+/**
+ * Ucestanost takta tajmera koji generise prekide (ACLK) i broj taktova
+ * izmedju dva prekida
+ */
+#define HAL_TIMER_HZ     32768
+#define HAL_TIMER_PERIOD 1024
+
+/**
+ * Najduze trajanje jedne konverzije u nanosekundama: 4 takta
+ * uzorkovanja (ADC12SHT0 = 0) i 13 taktova konverzije ADC12CLK, kada je
+ * MODOSC na najnizoj ucestanosti (4,2 MHz). Pri 5 MHz konverzija traje
+ * 3,4 us, pa sekvenca od 8 konverzija (podrazumevano) traje oko 27 us,
+ * a od 16 oko 54 us
+ */
+#define HAL_ADC_CONV_NS 4050
+
+/**
+ * Koliko taktova tajmera pre prekida pocinje sekvenca konverzija:
+ * najduze trajanje sekvence zaokruzeno navise i jos jedan takt za
+ * prekidnu rutinu AD konvertora (3 za 8 konverzija, 4 za 16)
+ */
+#define HAL_ADC_LEAD ((2UL * HAL_ADC_OVERSAMPLE * HAL_ADC_CONV_NS * HAL_TIMER_HZ \
+		+ 999999999UL) / 1000000000UL + 1)
+
+/**
+ * @brief Inicijalizacija svih periferija koje koristi igrica
+ */
+void HAL_Init(void);
+
+/**
+ * @brief Globalna dozvola prekida
+ */
+void HAL_EnableInterrupts(void);
+
+/**
+ * @brief Poslednja vrednost AD konvertora za potenciometar igraca
+ * @param Redni broj igraca (0 ili 1)
+ * @return Srednja vrednost poslednje sekvence, u opsegu 0 - HAL_ADC_MAX
+ */
+unsigned int HAL_ReadPaddle(uint8_t);
+
+/**
+ * @brief Sekvenca AD konverzija van rasporeda tajmera
+ *
+ * Vraca se tek kada su rezultati predati kroz HAL_PaddleHandler. Poziva
+ * se sa dozvoljenim prekidima, za kasno ocitavanje igraca (LATE_LATCH).
+ */
+void HAL_SamplePaddles(void);
+
+/**
+ * @brief Slucajna vrednost iz suma AD konvertora
+ * @return 16 bitova sastavljenih od najnizih bitova vise konverzija
+ *
+ * Poziva se jednom, posle HAL_Init a pre dozvole prekida, za pocetno
+ * stanje generatora pseudoslucajnih brojeva.
+ */
+uint16_t HAL_Entropy(void);
+
+/**
+ * @brief Obrada prekida tajmera (implementira aplikacija)
+ */
+void HAL_TimerHandler(void);
+
+/**
+ * @brief Obrada zavrsene sekvence AD konverzija (implementira aplikacija)
+ * @param Vrednost za prvog igraca (isto sto i HAL_ReadPaddle(0))
+ * @param Vrednost za drugog igraca
+ */
+void HAL_PaddleHandler(unsigned int, unsigned int);
+
+/**
+ * @brief Obrada pritiska tastera (implementira aplikacija)
+ */
+void HAL_ButtonHandler(void);
+
+#endif /* HAL_H_ */
@@ -0,0 +1,230 @@
+/**
+ * @file hal_msp430.c
+ * @brief Implementacija sloja za apstrakciju hardvera za MSP430F5438A
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Sadrzi inicijalizaciju periferija, prekidne rutine tajmera i tastera
+ * i DMA transport za red deskriptora drajvera za OLED. Prekidna rutina
+ * AD konvertora je u fajlu adc_int.asm.
+ */
+#include "hal.h"
+#include "init.h"
+#include "oled_queue.h"
+#include "trace.h"
+
+typedef char adc_sequence_fits[HAL_ADC_OVERSAMPLE_SHIFT <= 3 ? 1 : -1];
+
+/**
+ * Vrednosti potenciometara koji predstavljaju polozaj igraca.
+ * Ucitavaju se u prekidnoj rutini AD konvertora, jednom po sekvenci
+ */
+volatile unsigned int adc1val = HAL_ADC_MAX/2, adc2val = HAL_ADC_MAX/2;
+
+/**
+ * Indikator da DMA transport trenutno salje deskriptore iz reda.
+ */
+static volatile uint8_t dma_running = 0;
+
+/**
+ * @brief Inicijalizacija svih periferija koje koristi igrica
+ */
+void HAL_Init(void)
+{
+    WDTCTL = WDTPW | WDTHOLD;	// Stop watchdog timer
+
+    initADC();
+	initTMRA();
+	initTMRA1();
+	initMBUS1();
+	initDMA();
+	initBUTTON();
+}
+
+/**
+ * @brief Globalna dozvola prekida
+ */
+void HAL_EnableInterrupts(void)
+{
+    __bis_SR_register(GIE);		// globalna dozvola maskirajucih prekida
+}
+
+/**
+ * @brief Poslednja vrednost AD konvertora za potenciometar igraca
+ * @param Redni broj igraca (0 ili 1)
+ * @return Srednja vrednost poslednje sekvence, u opsegu 0 - HAL_ADC_MAX
+ */
+unsigned int HAL_ReadPaddle(uint8_t ch)
+{
+	return ch ? adc2val : adc1val;
+}
+
+/**
+ * @brief Sekvenca AD konverzija van rasporeda tajmera
+ *
+ * Sekvenca se pokrece softverski (ADC12SC), kao u HAL_Entropy, ali se
+ * rezultati preuzimaju u prekidnoj rutini; ceka se da ona obrise
+ * indikator kraja sekvence, pa se okidanje vraca na tajmer.
+ */
+void HAL_SamplePaddles(void)
+{
+	while(ADC12CTL1 & ADC12BUSY);		// sekvenca koju je pokrenuo tajmer
+	ADC12CTL0 &= ~ADC12ENC;
+	ADC12CTL1 &= ~ADC12SHS_3;			// okidanje bitom ADC12SC
+	ADC12CTL0 |= ADC12ENC;
+	ADC12CTL0 |= ADC12SC;
+	while(ADC12CTL1 & ADC12BUSY);
+	while(ADC12IFG & ADC12IE);			// prekidna rutina jos nije izvrsena
+
+	ADC12CTL0 &= ~ADC12ENC;
+	ADC12CTL1 |= ADC12SHS_1;			// ponovo okidanje tajmerom
+	ADC12CTL0 |= ADC12ENC;
+}
+
+/**
+ * @brief Slucajna vrednost iz suma AD konvertora
+ * @return 16 bitova sastavljenih od najnizih bitova vise konverzija
+ *
+ * Sekvenca konverzija se pokrece softverski (ADC12SC) umesto tajmerom,
+ * i od svake sekvence se uzima po najnizi bit prve konverzije oba
+ * kanala, koji je kod potenciometra u mirovanju sum. Poziva se pre
+ * dozvole prekida; indikator kraja sekvence ostaje postavljen, pa
+ * prekidna rutina posle dozvole prekida preuzme poslednju sekvencu.
+ */
+uint16_t HAL_Entropy(void)
+{
+	uint16_t e = 0;
+	uint8_t n;
+
+	ADC12CTL0 &= ~ADC12ENC;
+	ADC12CTL1 &= ~ADC12SHS_3;		// okidanje bitom ADC12SC
+	ADC12CTL0 |= ADC12ENC;
+
+	for(n = 0; n < 8; n++)
+	{
+		ADC12CTL0 |= ADC12SC;
+		while(!(ADC12IFG & ADC12IFG1));
+		while(ADC12CTL1 & ADC12BUSY);
+		e = (e << 2) | ((ADC12MEM0 & 1) << 1) | (ADC12MEM1 & 1);
+	}
+
+	ADC12CTL0 &= ~ADC12ENC;
+	ADC12CTL1 |= ADC12SHS_1;		// ponovo okidanje tajmerom
+	ADC12CTL0 |= ADC12ENC;
+	return e;
+}
+
+/**
+ * @brief Pokretanje DMA prenosa jednog deskriptora
+ * @param Deskriptor koji se salje, ili 0 ako je red ispraznjen
+ *
+ * DMA kanal 0 je okidan sa UCB0TXIFG (initDMA), pa se bajt prebacuje
+ * u predajni registar cim se on oslobodi. Okidac je osetljiv na ivicu,
+ * a UCTXIFG je vec postavljen, pa se fleg obrise i ponovo postavi da
+ * bi se generisao prvi zahtev.
+ */
+static void DMA_Start(const OLEDQ_Desc *d)
+{
+	if(!d)
+	{
+		HAL_CS_HIGH();
+		dma_running = 0;
+		TRACE(TRACE_SPI_END, 1);
+		return;
+	}
+
+	if(d->dc == OLEDQ_DATA)
+		HAL_DC_HIGH();
+	else
+		HAL_DC_LOW();
+
+	__data16_write_addr((unsigned short)&DMA0SA, (unsigned long)d->buf);
+	DMA0SZ = d->len;
+	DMA0CTL |= DMAEN;
+
+	UCB0IFG &= ~UCTXIFG;
+	UCB0IFG |= UCTXIFG;
+}
+
+/**
+ * @brief Pokretanje transporta ako trenutno ne salje
+ *
+ * Poziva se iz OLEDQ_PushData i OLEDQ_PushCommands. Provera i pokretanje
+ * se izvrsavaju sa zabranjenim prekidima, jer DMA prekidna rutina menja
+ * isti indikator kada isprazni red.
+ */
+void OLEDQ_TransportKick(void)
+{
+	hal_irq_t state;
+	HAL_IRQ_SAVE(state);
+	if(!dma_running)
+	{
+		const OLEDQ_Desc *d = OLEDQ_Current();
+		if(d)
+		{
+			dma_running = 1;
+			TRACE(TRACE_SPI_START, 1);
+			HAL_CS_LOW();
+			DMA_Start(d);
+		}
+	}
+	HAL_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief Poziva se dok se ceka na transport
+ *
+ * DMA radi nezavisno od procesora, pa nije potrebno nista raditi.
+ */
+void OLEDQ_TransportWait(void)
+{
+	__no_operation();
+}
+
+/**
+ * @brief Prekidna rutina DMA kontrolera
+ *
+ * Kada DMA prebaci poslednji bajt deskriptora u predajni registar,
+ * ceka se da se taj bajt posalje, jer se DC signal sme promeniti tek
+ * posle poslednjeg takta. Potom se pokrece sledeci deskriptor iz reda.
+ */
+#pragma vector=DMA_VECTOR
+__interrupt void DMA_ISR(void)
+{
+	switch(__even_in_range(DMAIV, 16))
+	{
+	case 2:		// DMA0IFG
+		while(UCB0STAT & UCBUSY);
+		DMA_Start(OLEDQ_Advance());
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Prekidna rutina tastera S4
+ *
+ * Poziva se obrada pritiska tastera, pa se potom brise indikator prekida
+ * iz Interrupt Flag registra.
+ */
+#pragma vector=PORT2_VECTOR
+__interrupt void port2handler(void)
+{
+	HAL_ButtonHandler();
+	P2IFG &= ~BIT7;				// brisanje flega
+}
+
+/**
+ * @brief Prekidna rutina TajmerA0
+ *
+ * Poziva se obrada prekida tajmera, koja signalizira da je vreme da se
+ * prikaze novi frejm na Oled W. Procesor se budi iz rezima male
+ * potrosnje u koji ga je uveo HAL_SLEEP.
+ */
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void Timer_A (void)
+{
+	HAL_TimerHandler();
+	__bic_SR_register_on_exit(LPM0_bits);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file hal_msp430.h
+ * @brief Implementacija sloja za apstrakciju hardvera za MSP430F5438A
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * OLED W Click plocica je na MikroBusu 1: SPI B0, CS na P3.0,
+ * DC na P4.1 i RST na P2.0.
+ */
+#ifndef HAL_MSP430_H_
+#define HAL_MSP430_H_
+
+#include <msp430.h>
+
+#define HAL_CS_HIGH()			(P3OUT |=  BIT0)
+#define HAL_CS_LOW()			(P3OUT &= ~BIT0)
+#define HAL_DC_HIGH()			(P4OUT |=  BIT1)
+#define HAL_DC_LOW()			(P4OUT &= ~BIT1)
+#define HAL_RST_HIGH()			(P2OUT |=  BIT0)
+#define HAL_RST_LOW()			(P2OUT &= ~BIT0)
+
+#define HAL_SPI_WRITE(b)		(UCB0TXBUF = (b))
+#define HAL_SPI_TX_READY()		(UCB0IFG & UCTXIFG)
+#define HAL_SPI_BUSY()			(UCB0STAT & UCBUSY)
+
+#define HAL_DELAY_CYCLES(n)		__delay_cycles(n)
+#define HAL_COST(n)				((void)0)
+
+#define HAL_TIMESTAMP()			TA1R
+#define HAL_TIMER_COUNT()		TA0R
+
+#define HAL_IRQ_SAVE(s)			do { (s) = __get_interrupt_state(); __disable_interrupt(); } while(0)
+#define HAL_IRQ_RESTORE(s)		__set_interrupt_state(s)
+
+#define HAL_SLEEP()				__bis_SR_register(LPM0_bits | GIE)
+
+/**
+ * Tip promenljive u kojoj se cuva stanje prekida
+ */
+typedef unsigned short hal_irq_t;
+
+#endif /* HAL_MSP430_H_ */
@@ -0,0 +1,380 @@
+/**
+ * @file bench.c
+ * @brief Merenje brzine funkcija za iscrtavanje i fiziku na racunaru
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Svaka funkcija se meri posebno, a zatim i ceo frejm (RefreshScreen).
+ * Prng_Next i Prng_Range se mere sa opsegom polozaja nove loptice.
+ * Na kraju se meri korak fizike sa slaganjem frejma za 1 do MAX_BALLS
+ * loptica (BallsN) i raniji nacin slanja slike bajt po bajt
+ * (OLED_PutPictureBytes). Posle merenja se ista slika salje kroz
+ * emulator kontrolera bajt po bajt i u nizu, i za oba nacina se ispisuje
+ * saobracaj na magistrali, izracunato vreme na zici i trajanje na
+ * simuliranom SMCLK (Bus).
+ *
+ * Imena merenja se ne menjaju izmedju commit-ova, da bi se rezultati
+ * mogli porediti; nova merenja se samo dodaju na kraj. Kada se funkcija
+ * koju je merenje meri zameni, merenje meri odgovarajuci deo nove
+ * implementacije:
+ *  - DrawBall, DrawBoard: polozaji sprajtova i njihovo iscrtavanje u bafer
+ *  - RemoveBall, RemoveBoard: iscrtavanje i brisanje sprajtova (brise se
+ *    samo ono sto je iscrtano, pa se brisanje ne moze meriti samo)
+ *  - RedrawMiddle: popravka staticnog sloja posle brisanja (Sprite_Erase
+ *    bez iscrtanih sprajtova), koja je zamenila precrtavanje sredine
+ *  - LoadBackground: ucitavanje pozadine i kopiranje u bafer (slaganje)
+ * Sa RENDER_STREAM nema bafera frejma, pa se ta merenja preskacu.
+ * Pre svakog merenja igra se vraca u pocetno stanje (InitGame, Prng_Seed),
+ * pa su ulazi isti pri svakom pokretanju. Za funkciju OLED_PutPicture se
+ * koristi prazan transport: bajtovi se samo broje, bez emulacije
+ * kontrolera SSD1306.
+ *
+ * Rezultat svakog merenja je jedan red u JSON formatu:
+ *  {"label":"...","kernel":"DrawBall","iterations":N,"ns_per_call":X,"calls_per_sec":Y}
+ * Polje label se zadaje argumentom (npr. hash commit-a), da bi se
+ * rezultati sa vise commit-ova mogli porediti.
+ *
+ * Upotreba: pong_bench [oznaka [broj_ponavljanja]]
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "hal.h"
+#include "game.h"
+#include "input.h"
+#include "oled.h"
+#include "prng.h"
+#include "ssd1306_emu.h"
+
+/**
+ * Podrazumevani broj poziva funkcije po merenju
+ */
+#define DEF_ITERATIONS 200000L
+
+/**
+ * Broj merenja od kojih se uzima najbrze
+ */
+#define RUNS 5
+
+/**
+ * Visina terena u pikselima i velicina igraca
+ */
+#define FIELD_HEIGHT (8 * OLED_BYTE_HEIGHT)
+#define BOARD_SIZE   8
+
+/**
+ * Indikator koji postavlja simulirani tajmer
+ */
+static volatile uint8_t TimerFlag = 0;
+
+/**
+ * @brief Obrada pritiska tastera (ne koristi se)
+ */
+void HAL_ButtonHandler(void)
+{
+}
+
+/**
+ * @brief Obrada simuliranog prekida tajmera
+ */
+void HAL_TimerHandler(void)
+{
+	TimerFlag = 1;
+}
+
+/**
+ * @brief Trenutno vreme u nanosekundama
+ */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Pocetno stanje za merenje: nova loptica i ucitana pozadina
+ */
+static void Setup(void)
+{
+	InitGame();
+	Prng_Seed(PRNG_SEED);
+	Input_Reset();
+	ServeBall();
+	LoadBackground();
+}
+
+/**
+ * @brief Igraci prate lopticu, pa se loptica uvek odbija
+ *
+ * Tako NextState prolazi kroz uobicajene putanje (kretanje, odbijanje
+ * od zidova i igraca) umesto da stalno gubi lopticu.
+ */
+static void FollowBall(void)
+{
+	int x, y;
+	GetBall(&x, &y);
+	y -= BOARD_SIZE / 2;
+	if(y < 0)
+		y = 0;
+	if(y > FIELD_HEIGHT - BOARD_SIZE)
+		y = FIELD_HEIGHT - BOARD_SIZE;
+	SetBoards(y, y);
+}
+
+static void K_NextState(void)		{ FollowBall(); NextState(); }
+#if !RENDER_STREAM
+static void K_DrawBall(void)		{ DrawBall(); DrawSprites(1); }
+static void K_RemoveBall(void)		{ DrawBall(); DrawSprites(1); EraseSprites(); }
+static void K_DrawBoard(void)		{ DrawBoard(); DrawSprites(0); }
+static void K_RemoveBoard(void)		{ DrawBoard(); DrawSprites(0); EraseSprites(); }
+static void K_RedrawMiddle(void)	{ EraseSprites(); }
+#endif
+static void K_WriteResult(void)		{ WriteResult(); }
+static void K_LoadBackground(void)	{ LoadBackground(); ComposeFrame(); }
+static void K_Compose(void)			{ DrawBoard(); DrawBall(); ComposeFrame(); }
+static void K_ServeBall(void)		{ ServeBall(); }
+
+/**
+ * Rezultat generatora, da prevodilac ne izostavi poziv
+ */
+static volatile uint16_t prng_sink;
+
+static void K_PrngNext(void)		{ prng_sink = Prng_Next(); }
+static void K_PrngRange(void)		{ prng_sink = Prng_Range(FIELD_HEIGHT - 2); }
+
+/**
+ * Broj loptica za merenje K_Balls
+ */
+static uint8_t bench_balls = 1;
+
+/**
+ * @brief Fizika i slaganje frejma sa bench_balls loptica
+ *
+ * Loptice koje igraci promase se odmah zamenjuju novim, da bi broj
+ * loptica u merenju bio stalan.
+ */
+static void K_Balls(void)
+{
+	while(GetBallCount() < bench_balls)
+		SpawnBall();
+	FollowBall();
+	NextState();
+	DrawBoard();
+	DrawBall();
+	ComposeFrame();
+}
+
+static void K_PutPicture(void)
+{
+	OLED_PutPicture(GetDisplayedFrame());
+}
+
+/**
+ * Prva kolona kontrolera SSD1306 na koju je povezan displej
+ */
+#define FIRST_COLUMN 32
+
+/**
+ * @brief Slanje slike bajt po bajt, kao pre slanja u nizu
+ * @param Slika
+ *
+ * Za svaku stranu se komandama Page Addressing rezima postavljaju
+ * strana i kolona (tri komande), a zatim se svaki bajt salje posebno
+ * (OLED_Data), sa promenom CS i DC signala i cekanjem magistrale za
+ * svaki bajt. Kontroler mora biti u Page Addressing rezimu (PageMode).
+ */
+static void PutPictureBytes(const uint8_t *pic)
+{
+	uint8_t i, j;
+
+	for(i = 0; i < OLED_BYTE_HEIGHT; i++)
+	{
+		OLED_Command(0xB0 | i);
+		OLED_Command(SSD1306_SETHIGHCOLUMN | (FIRST_COLUMN >> 4));
+		OLED_Command(SSD1306_SETLOWCOLUMN | (FIRST_COLUMN & 0x0F));
+		for(j = 0; j < OLED_WIDTH; j++)
+			OLED_Data(*pic++);
+	}
+}
+
+/**
+ * @brief Izbor rezima adresiranja kontrolera
+ * @param 1 - Page Addressing, 0 - horizontalni (kao posle OLED_Initialize)
+ */
+static void PageMode(uint8_t on)
+{
+	OLED_Command(SSD1306_MEMORYMODE);
+	OLED_Command(on ? 0x02 : 0x00);
+}
+
+static void K_PutPictureBytes(void)
+{
+	PutPictureBytes(GetDisplayedFrame());
+}
+
+/**
+ * @brief Ceo frejm: simulirani prekid tajmera i RefreshScreen
+ */
+static void K_Frame(void)
+{
+	HAL_LinuxTick();
+	AdvanceClock(TimerFlag);
+	Input_Update();
+	RefreshScreen(Input_Paddle(0), Input_Paddle(1), 1);
+	TimerFlag = 0;
+	OLED_WaitIdle();
+}
+
+/**
+ * Opis jednog merenja
+ */
+typedef struct
+{
+	const char *name;
+	void (*kernel)(void);
+	long div;		// deli broj poziva za sporije funkcije
+} Bench;
+
+static const Bench benches[] = {
+	{"NextState",      K_NextState,      1},
+#if !RENDER_STREAM
+	{"DrawBall",       K_DrawBall,       1},
+	{"RemoveBall",     K_RemoveBall,     1},
+	{"DrawBoard",      K_DrawBoard,      1},
+	{"RemoveBoard",    K_RemoveBoard,    1},
+#endif
+	{"WriteResult",    K_WriteResult,    1},
+#if !RENDER_STREAM
+	{"RedrawMiddle",   K_RedrawMiddle,   1},
+#endif
+	{"LoadBackground", K_LoadBackground, 4},
+	{"OLED_PutPicture",K_PutPicture,     40},
+	{"Frame",          K_Frame,          20},
+	{"Compose",        K_Compose,        1},
+	{"ServeBall",      K_ServeBall,      1},
+	{"Prng_Next",      K_PrngNext,       1},
+	{"Prng_Range",     K_PrngRange,      1},
+	{"OLED_PutPictureBytes", K_PutPictureBytes, 40},
+};
+
+/**
+ * @brief Merenje jedne funkcije
+ * @param Opis merenja
+ * @param Oznaka rezultata
+ * @param Broj poziva
+ *
+ * Funkcija se meri RUNS puta, svaki put iz istog pocetnog stanja, i
+ * ispisuje se najbrze merenje.
+ */
+static void Run(const Bench *b, const char *label, long iters)
+{
+	double best = 0;
+	int r;
+	long n;
+
+	for(r = 0; r < RUNS; r++)
+	{
+		double t0, t;
+		HAL_Init();
+		HAL_LinuxSetEmulation(0);
+		Setup();
+
+		t0 = Now();
+		for(n = 0; n < iters; n++)
+			b->kernel();
+		t = Now() - t0;
+
+		if(r == 0 || t < best)
+			best = t;
+	}
+
+	printf("{\"label\":\"%s\",\"kernel\":\"%s\",\"iterations\":%ld,"
+			"\"ns_per_call\":%.2f,\"calls_per_sec\":%.0f}\n",
+			label, b->name, iters, best / iters, iters * 1e9 / best);
+}
+
+/**
+ * @brief Saobracaj na magistrali za celu sliku poslatu bajt po bajt i u nizu
+ * @param Oznaka rezultata
+ *
+ * Ista slika se salje kroz emulator kontrolera SSD1306, jednom
+ * funkcijom PutPictureBytes i jednom funkcijom OLED_PutPicture. Emulator
+ * broji bajtove komandi i podataka i promene CS i DC signala i
+ * proverava da je prikazana slika ista kao poslata. Polje wire_us je
+ * izracunato vreme na zici: broj bajtova puta 8 taktova SPI pri
+ * EMU_DEF_SPI_CLOCK. Polje smclk_cycles je trajanje slanja na
+ * simuliranom SMCLK (hal_linux.c), sa promenama CS i DC i cekanjem
+ * UCBUSY i UCTXIFG; iz njega se racuna broj korisnih bajtova u sekundi.
+ */
+static void Bus(const char *label)
+{
+	static uint8_t pic[IMAGE_SIZE];
+	EMU_Stats st;
+	unsigned int k, diff;
+	uint16_t t0, cycles;
+	uint8_t burst;
+
+	for(k = 0; k < IMAGE_SIZE; k++)
+		pic[k] = (uint8_t)(k * 37 + 11);
+
+	HAL_Init();
+	HAL_LinuxSetEmulation(1);
+	OLED_Initialize();
+	EMU_SetSPIClock(EMU_DEF_SPI_CLOCK);
+	for(burst = 0; burst < 2; burst++)
+	{
+		OLED_Clear();
+		PageMode(!burst);
+		EMU_FrameStats(&st);
+		t0 = HAL_TIMESTAMP();
+		if(burst)
+			OLED_PutPicture(pic);
+		else
+			PutPictureBytes(pic);
+		cycles = HAL_TIMESTAMP() - t0;
+		EMU_FrameStats(&st);
+		diff = EMU_Compare(pic);
+		PageMode(0);
+
+		printf("{\"label\":\"%s\",\"bus\":\"%s\",\"cmd_bytes\":%lu,"
+				"\"data_bytes\":%lu,\"cs_toggles\":%lu,\"dc_toggles\":%lu,"
+				"\"wire_us\":%.1f,\"smclk_cycles\":%u,"
+				"\"payload_bytes_per_sec\":%.0f,\"mismatched\":%u}\n",
+				label, burst ? "OLED_PutPicture" : "OLED_PutPictureBytes",
+				st.cmd_bytes, st.data_bytes, st.cs_toggles, st.dc_toggles,
+				st.wire_us, cycles, (double)IMAGE_SIZE * SIM_SMCLK_HZ / cycles, diff);
+	}
+}
+
+/**
+ * @brief Glavna funkcija
+ */
+int main(int argc, char **argv)
+{
+	const char *label = argc > 1 ? argv[1] : "local";
+	long iters = argc > 2 ? atol(argv[2]) : DEF_ITERATIONS;
+	unsigned int k;
+	char name[16];
+	Bench balls = { name, K_Balls, 1 };
+
+	OLED_Initialize();
+	for(k = 0; k < sizeof(benches) / sizeof(benches[0]); k++)
+		Run(&benches[k], label, iters / benches[k].div > 0 ? iters / benches[k].div : 1);
+
+	// Cena fizike i iscrtavanja u zavisnosti od broja loptica
+	for(bench_balls = 1; bench_balls <= MAX_BALLS; bench_balls++)
+	{
+		sprintf(name, "Balls%u", bench_balls);
+		Run(&balls, label, iters);
+	}
+
+	Bus(label);
+	return 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,43 @@
+/**
+ * @file check.c
+ * @brief Brojanje provera i ispis gresaka za provere na racunaru
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "check.h"
+
+/**
+ * Broj provera i broj gresaka
+ */
+static unsigned long checks = 0, errors = 0;
+
+int Check_True(int ok, const char *fmt, ...)
+{
+	va_list ap;
+
+	checks++;
+	if(ok || errors++ >= CHECK_MAX_REPORTS)
+		return ok;
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+	return ok;
+}
+
+int Check_Equal(const char *what, long got, long want)
+{
+	return Check_True(got == want, "%s: %ld umesto %ld", what, got, want);
+}
+
+int Check_Done(const char *name)
+{
+	printf("%s: %lu provera, %lu gresaka\n", name, checks, errors);
+	return errors != 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,44 @@
+/**
+ * @file check.h
+ * @brief Brojanje provera i ispis gresaka za provere na racunaru
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Svaki program host/test_*.c proverava jedan modul i zavrsava se sa
+ * Check_Done: ispisuje se broj provera i gresaka, a izlazni kod je 0
+ * ako su sve provere prosle. Ispisuje se samo prvih CHECK_MAX_REPORTS
+ * gresaka.
+ */
+#ifndef CHECK_H_
+#define CHECK_H_
+
+/**
+ * Broj gresaka koje se ispisuju
+ */
+#define CHECK_MAX_REPORTS 10
+
+/**
+ * @brief Evidentiranje jedne provere
+ * @param Uslov koji mora da vazi
+ * @param Opis greske, u formatu kao za printf, i njegovi argumenti
+ * @return Uslov
+ */
+int Check_True(int, const char *, ...);
+
+/**
+ * @brief Provera da je dobijena vrednost jednaka ocekivanoj
+ * @param Opis provere
+ * @param Dobijena vrednost
+ * @param Ocekivana vrednost
+ * @return Da li su vrednosti jednake
+ */
+int Check_Equal(const char *, long, long);
+
+/**
+ * @brief Ispis broja provera i gresaka
+ * @param Ime programa
+ * @return Izlazni kod programa (0 ako nije bilo gresaka)
+ */
+int Check_Done(const char *);
+
+#endif /* CHECK_H_ */
@@ -0,0 +1,375 @@
+/**
+ * @file hal_linux.c
+ * @brief Implementacija sloja za apstrakciju hardvera za Linux
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Bajtovi poslati preko SPI magistrale se prosledjuju emulatoru
+ * kontrolera SSD1306 (ssd1306_emu.c), zajedno sa stanjima CS i DC
+ * signala. Spustanje RST signala resetuje emulator.
+ *
+ * Simulirani AD konvertor daje dva trougaona signala razlicitih perioda
+ * sa malo pseudoslucajnog suma, tako da je svako pokretanje isto.
+ *
+ * Vreme se ne meri satom racunara, nego se broje simulirani taktovi
+ * SMCLK (1.048576 MHz, kao na mikrokontroleru). Vreme napreduje samo za
+ * modelovane troskove: prenos bajta preko SPI magistrale i rad
+ * procesora oko nje (promene CS i DC, cekanje UCBUSY i UCTXIFG),
+ * HAL_DELAY_CYCLES, AD sekvencu koju ceka procesor (HAL_SamplePaddles),
+ * procenjeno trajanje delova igrice (HAL_COST, SIM_COST_* iz
+ * hal_linux.h), i do sledeceg prekida tajmera u HAL_LinuxTick. Ostalo
+ * racunanje ne trosi simulirano vreme, pa su svi rezultati pri svakom
+ * pokretanju isti; stvarno trajanje na racunaru meri bench.c.
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include "hal.h"
+#include "ssd1306_emu.h"
+
+/**
+ * Periodi simuliranih potenciometara, izrazeni u prekidima tajmera
+ */
+#define SIM_PERIOD1 150
+#define SIM_PERIOD2 97
+
+/**
+ * Amplituda simuliranog suma AD konvertora
+ */
+#define SIM_NOISE 8
+
+/**
+ * Broj taktova simuliranog SMCLK (SIM_SMCLK_HZ) u periodu Timera A
+ */
+#define SIM_ACLK_DIV     (SIM_SMCLK_HZ / HAL_TIMER_HZ)
+#define SIM_TICK_CYCLES  (SIM_ACLK_DIV * HAL_TIMER_PERIOD)
+
+/**
+ * Trajanje prenosa bajta preko SPI magistrale (SMCLK / 1, init.c)
+ */
+#define SIM_SPI_CYCLES 8
+
+/**
+ * Procenjen rad procesora oko magistrale, u taktovima SMCLK: promena
+ * CS ili DC pina (BIS.B/BIC.B na PxOUT) i jedna provera UCBUSY ili
+ * UCTXIFG u petlji cekanja (BIT.B i skok)
+ */
+#define SIM_COST_PIN  5
+#define SIM_COST_POLL 6
+
+/**
+ * Trajanje sekvence AD konverzija (2 * HAL_ADC_OVERSAMPLE konverzija od
+ * HAL_ADC_CONV_NS) i koliko se ranije od prekida tajmera zavrsava:
+ * pocinje HAL_ADC_LEAD taktova ACLK pre prekida (init.c)
+ */
+#define SIM_ADC_CYCLES (2UL * HAL_ADC_OVERSAMPLE * HAL_ADC_CONV_NS * (SIM_SMCLK_HZ >> 10) \
+		/ (1000000000UL >> 10))
+#define SIM_ADC_LEAD   (HAL_ADC_LEAD * SIM_ACLK_DIV - SIM_ADC_CYCLES)
+
+/**
+ * Stanja simuliranih pinova
+ */
+static uint8_t pins[3] = {1, 1, 1};
+
+/**
+ * Broj bajtova poslatih preko SPI magistrale
+ */
+static unsigned long spi_bytes = 0;
+
+/**
+ * Indikator da se bajtovi prosledjuju emulatoru
+ */
+static uint8_t emulation = 1;
+
+/**
+ * Simulirano vreme u prekidima tajmera i stanje generatora suma
+ */
+static unsigned long ticks = 0;
+static uint32_t noise_seed = 1;
+
+/**
+ * Simulirani takt SMCLK i trenutak sledeceg prekida tajmera
+ */
+static uint32_t smclk = 0;
+static uint32_t next_tick = SIM_TICK_CYCLES;
+
+/**
+ * Trenutak kada magistrala zavrsava slanje poslednjeg upisanog bajta
+ */
+static uint32_t spi_done = 0;
+
+/**
+ * Vrednosti simuliranog AD konvertora
+ */
+static unsigned int adc[2] = {HAL_ADC_MAX/2, HAL_ADC_MAX/2};
+
+/**
+ * @brief Napredovanje simuliranog vremena do zadatog trenutka
+ * @param Trenutak u taktovima SMCLK; ako je prosao, vreme se ne menja
+ */
+static void AdvanceTo(uint32_t t)
+{
+	if((int32_t)(t - smclk) > 0)
+		smclk = t;
+}
+
+/**
+ * @brief Inicijalizacija svih periferija koje koristi igrica
+ */
+void HAL_Init(void)
+{
+	pins[HAL_PIN_CS] = pins[HAL_PIN_DC] = pins[HAL_PIN_RST] = 1;
+	spi_bytes = 0;
+	ticks = 0;
+	noise_seed = 1;
+	smclk = 0;
+	next_tick = SIM_TICK_CYCLES;
+	spi_done = 0;
+	EMU_Reset();
+}
+
+/**
+ * @brief Globalna dozvola prekida
+ *
+ * Prvi prekid tajmera je na prvoj granici perioda posle dozvole; dok su
+ * prekidi bili zabranjeni (npr. kasnjenja u OLED_Initialize) nisu se
+ * gomilali.
+ */
+void HAL_EnableInterrupts(void)
+{
+	next_tick = (smclk / SIM_TICK_CYCLES + 1) * SIM_TICK_CYCLES;
+}
+
+/**
+ * @brief Poslednja vrednost simuliranog AD konvertora
+ * @param Redni broj igraca (0 ili 1)
+ * @return Srednja vrednost poslednje sekvence, u opsegu 0 - HAL_ADC_MAX
+ */
+unsigned int HAL_ReadPaddle(uint8_t ch)
+{
+	return adc[ch ? 1 : 0];
+}
+
+/**
+ * @brief Postavljanje simuliranog pina
+ * @param Pin (HAL_PIN_CS, HAL_PIN_DC ili HAL_PIN_RST)
+ * @param Nova vrednost
+ */
+void HAL_LinuxPin(uint8_t pin, uint8_t val)
+{
+	pins[pin] = val;
+	if(pin != HAL_PIN_RST)
+		smclk += SIM_COST_PIN;
+	if(!emulation)
+		return;
+	switch(pin)
+	{
+	case HAL_PIN_CS:
+		EMU_SetCS(val);
+		break;
+	case HAL_PIN_DC:
+		EMU_SetDC(val);
+		break;
+	default:
+		if(!val)
+			EMU_Reset();
+		break;
+	}
+}
+
+/**
+ * @brief Slanje bajta preko simulirane SPI magistrale
+ * @param Bajt koji se salje
+ *
+ * Kao na USCI modulu, bajt ceka u predajnom registru dok se prethodni
+ * salje iz pomerackog registra. Upis ceka da se predajni registar
+ * oslobodi; procesor ne ceka kraj slanja, to radi HAL_SPI_BUSY.
+ */
+void HAL_LinuxSPIWrite(uint8_t b)
+{
+	AdvanceTo(spi_done - SIM_SPI_CYCLES);
+	if((int32_t)(spi_done - smclk) < 0)
+		spi_done = smclk;
+	spi_done += SIM_SPI_CYCLES;
+	spi_bytes++;
+	if(emulation)
+		EMU_Write(b);
+}
+
+/**
+ * @brief Provera da li je predajni registar slobodan (UCTXIFG)
+ * @return Uvek 1: provera ceka dok se registar ne oslobodi
+ */
+uint8_t HAL_LinuxSPIReady(void)
+{
+	smclk += SIM_COST_POLL;
+	AdvanceTo(spi_done - SIM_SPI_CYCLES);
+	return 1;
+}
+
+/**
+ * @brief Provera da li magistrala jos salje (UCBUSY)
+ * @return Uvek 0: provera ceka kraj slanja poslednjeg bajta
+ */
+uint8_t HAL_LinuxSPIBusy(void)
+{
+	smclk += SIM_COST_POLL;
+	AdvanceTo(spi_done);
+	return 0;
+}
+
+/**
+ * @brief Brojac tajmera koji generise prekide
+ *
+ * Broj taktova ACLK (HAL_TIMER_HZ) simuliranog vremena po modulu
+ * HAL_TIMER_PERIOD, kao TA0R na mikrokontroleru.
+ */
+unsigned int HAL_LinuxTimerCount(void)
+{
+	return (unsigned int)((smclk / SIM_ACLK_DIV) % HAL_TIMER_PERIOD);
+}
+
+/**
+ * @brief Slobodni brojac vremena, u taktovima SMCLK po modulu 2^16
+ */
+uint16_t HAL_LinuxTimestamp(void)
+{
+	return (uint16_t)smclk;
+}
+
+/**
+ * @brief Napredovanje simuliranog vremena
+ * @param Broj taktova SMCLK
+ */
+void HAL_LinuxSpend(unsigned long cycles)
+{
+	smclk += cycles;
+}
+
+/**
+ * @brief Trougaoni signal u opsegu 0 - HAL_ADC_MAX
+ * @param Trenutno vreme
+ * @param Period signala
+ */
+static unsigned int Triangle(unsigned long t, unsigned int period)
+{
+	unsigned long phase = t % period;
+	unsigned long half = period / 2;
+	if(phase > half)
+		phase = period - phase;
+	return (unsigned int)(phase * HAL_ADC_MAX / half);
+}
+
+/**
+ * @brief Dodavanje simuliranog suma vrednosti AD konvertora
+ * @param Vrednost bez suma
+ */
+static unsigned int AddNoise(unsigned int val)
+{
+	int n;
+	noise_seed = noise_seed * 1103515245UL + 12345UL;
+	n = (int)((noise_seed >> 16) % (2 * SIM_NOISE + 1)) - SIM_NOISE;
+	if((int)val + n < 0)
+		return 0;
+	if((int)val + n > HAL_ADC_MAX)
+		return HAL_ADC_MAX;
+	return val + n;
+}
+
+/**
+ * @brief Srednja vrednost HAL_ADC_OVERSAMPLE konverzija sa sumom
+ * @param Vrednost bez suma
+ *
+ * Isto kao prekidna rutina AD konvertora na mikrokontroleru (adc_int.asm).
+ */
+static unsigned int Oversample(unsigned int val)
+{
+	unsigned int sum = 0;
+	uint8_t n;
+
+	for(n = 0; n < HAL_ADC_OVERSAMPLE; n++)
+		sum += AddNoise(val);
+	return sum >> HAL_ADC_OVERSAMPLE_SHIFT;
+}
+
+/**
+ * @brief Slucajna vrednost iz simuliranog suma AD konvertora
+ * @return 16 bitova sastavljenih od najnizih bitova vise konverzija
+ *
+ * Kao na mikrokontroleru, uzima se najnizi bit oba kanala iz osam
+ * konverzija. Generator suma pocinje od istog stanja (HAL_Init), pa je
+ * i ova vrednost ista pri svakom pokretanju.
+ */
+uint16_t HAL_Entropy(void)
+{
+	uint16_t e = 0;
+	uint8_t n;
+
+	for(n = 0; n < 8; n++)
+		e = (e << 2) | ((AddNoise(adc[0]) & 1) << 1) | (AddNoise(adc[1]) & 1);
+	return e;
+}
+
+/**
+ * @brief Zavrsena sekvenca AD konverzija
+ *
+ * Signal potenciometara se menja samo sa prekidima tajmera, pa sekvenca
+ * izmedju dva prekida ima samo nov sum.
+ */
+static void Sample(void)
+{
+	adc[0] = Oversample(Triangle(ticks, SIM_PERIOD1));
+	adc[1] = Oversample(Triangle(ticks + SIM_PERIOD2 / 3, SIM_PERIOD2));
+	HAL_PaddleHandler(adc[0], adc[1]);
+}
+
+/**
+ * @brief Sekvenca AD konverzija van rasporeda tajmera
+ *
+ * Procesor ceka kraj sekvence, pa simulirano vreme napreduje za njeno
+ * trajanje.
+ */
+void HAL_SamplePaddles(void)
+{
+	smclk += SIM_ADC_CYCLES;
+	Sample();
+}
+
+/**
+ * @brief Napredovanje simuliranog vremena do sledeceg prekida tajmera
+ *
+ * Sekvenca AD konverzija se zavrsava SIM_ADC_LEAD taktova pre prekida
+ * (HAL_PaddleHandler), pa sledi prekid (HAL_TimerHandler), istim redom
+ * kao na mikrokontroleru. Ako je simulirano vreme vec preslo trenutak
+ * prekida (frejm je trajao duze od perioda), prekidi koji su u
+ * medjuvremenu pali se izvrsavaju odmah, jedan za drugim.
+ */
+void HAL_LinuxTick(void)
+{
+	do
+	{
+		ticks++;
+		AdvanceTo(next_tick - SIM_ADC_LEAD);
+		Sample();
+		AdvanceTo(next_tick);
+		HAL_TimerHandler();
+		next_tick += SIM_TICK_CYCLES;
+	} while((int32_t)(next_tick - smclk) <= 0);
+}
+
+/**
+ * @brief Ukljucivanje i iskljucivanje emulatora kontrolera SSD1306
+ * @param 0 - bajtovi se samo broje (prazan transport), 1 - emulacija
+ */
+void HAL_LinuxSetEmulation(uint8_t on)
+{
+	emulation = on;
+}
+
+/**
+ * @brief Ukupan broj bajtova poslatih preko SPI magistrale
+ */
+unsigned long HAL_LinuxSPIBytes(void)
+{
+	return spi_bytes;
+}
+
+#endif /* __MSP430__ */
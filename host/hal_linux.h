@@ -0,0 +1,135 @@
+/**
+ * @file hal_linux.h
+ * @brief Implementacija sloja za apstrakciju hardvera za Linux
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Periferije se simuliraju: bajtovi poslati preko SPI magistrale se
+ * broje, AD konvertor daje sinteticki signal, a vreme se meri
+ * simuliranim taktovima SMCLK (hal_linux.c).
+ */
+#ifndef HAL_LINUX_H_
+#define HAL_LINUX_H_
+
+#include <stdint.h>
+
+#define HAL_CS_HIGH()			HAL_LinuxPin(HAL_PIN_CS, 1)
+#define HAL_CS_LOW()			HAL_LinuxPin(HAL_PIN_CS, 0)
+#define HAL_DC_HIGH()			HAL_LinuxPin(HAL_PIN_DC, 1)
+#define HAL_DC_LOW()			HAL_LinuxPin(HAL_PIN_DC, 0)
+#define HAL_RST_HIGH()			HAL_LinuxPin(HAL_PIN_RST, 1)
+#define HAL_RST_LOW()			HAL_LinuxPin(HAL_PIN_RST, 0)
+
+#define HAL_SPI_WRITE(b)		HAL_LinuxSPIWrite(b)
+#define HAL_SPI_TX_READY()		HAL_LinuxSPIReady()
+#define HAL_SPI_BUSY()			HAL_LinuxSPIBusy()
+
+#define HAL_DELAY_CYCLES(n)		HAL_LinuxSpend(n)
+#define HAL_COST(n)				HAL_LinuxSpend(n)
+
+#define HAL_TIMESTAMP()			HAL_LinuxTimestamp()
+#define HAL_TIMER_COUNT()		HAL_LinuxTimerCount()
+
+#define HAL_IRQ_SAVE(s)			((s) = 0)
+#define HAL_IRQ_RESTORE(s)		((void)(s))
+
+#define HAL_SLEEP()				((void)0)
+
+/**
+ * Ucestanost simuliranog SMCLK, kao na mikrokontroleru
+ */
+#define SIM_SMCLK_HZ 1048576UL
+
+/**
+ * Procenjeno trajanje delova programa na MSP430 u taktovima SMCLK, za
+ * koje simulirano vreme napreduje pozivom HAL_COST (na mikrokontroleru
+ * HAL_COST ne radi nista). Vrednosti nisu izmerene na ploci, nego su
+ * procena broja instrukcija, pa sluze za poredjenje i proveru
+ * rasporedjivaca, a ne kao trajanje na ploci.
+ */
+#define SIM_COST_FILTER        60	// Filter, jedan odbirak (input.c)
+#define SIM_COST_BALL_STEP    120	// korak fizike jedne loptice (game.c)
+#define SIM_COST_BOUNCE       150	// odbijanje: Arith_Frac, HitBoard, ReflectY
+#define SIM_COST_SPRITE        40	// iscrtavanje ili brisanje sprajta (sprite.c)
+#define SIM_COST_SPRITE_COLUMN 20	// jedna kolona sprajta, dve strane
+#define SIM_COST_COPY_WORD      6	// jedna rec u Blit_Copy, Blit_Fill
+#define SIM_COST_DIFF_WORD      6	// jedna rec u Blit_Same (oled.c)
+#define SIM_COST_DIFF_RUN      80	// niz promenjenih bajtova u DiffPage
+#define SIM_COST_GLYPH         60	// jedna cifra u Text_Number (text.c)
+#define SIM_COST_ASSET_RUN     30	// jedan niz u Asset_Next (asset.c)
+
+/**
+ * Tip promenljive u kojoj se cuva stanje prekida
+ */
+typedef unsigned short hal_irq_t;
+
+/**
+ * Simulirani pinovi
+ */
+#define HAL_PIN_CS  0
+#define HAL_PIN_DC  1
+#define HAL_PIN_RST 2
+
+/**
+ * @brief Postavljanje simuliranog pina
+ * @param Pin (HAL_PIN_CS, HAL_PIN_DC ili HAL_PIN_RST)
+ * @param Nova vrednost
+ */
+void HAL_LinuxPin(uint8_t, uint8_t);
+
+/**
+ * @brief Slanje bajta preko simulirane SPI magistrale
+ * @param Bajt koji se salje
+ */
+void HAL_LinuxSPIWrite(uint8_t);
+
+/**
+ * @brief Provera da li je predajni registar slobodan (UCTXIFG)
+ * @return Uvek 1, posto simulirano vreme napreduje do oslobadjanja
+ */
+uint8_t HAL_LinuxSPIReady(void);
+
+/**
+ * @brief Provera da li magistrala jos salje (UCBUSY)
+ * @return Uvek 0, posto simulirano vreme napreduje do kraja slanja
+ */
+uint8_t HAL_LinuxSPIBusy(void);
+
+/**
+ * @brief Brojac tajmera koji generise prekide, u taktovima od
+ * HAL_TIMER_HZ po modulu HAL_TIMER_PERIOD (racuna se iz simuliranog vremena)
+ */
+unsigned int HAL_LinuxTimerCount(void);
+
+/**
+ * @brief Slobodni brojac vremena, u simuliranim taktovima SMCLK po
+ * modulu 2^16
+ */
+uint16_t HAL_LinuxTimestamp(void);
+
+/**
+ * @brief Napredovanje simuliranog vremena
+ * @param Broj taktova SMCLK
+ */
+void HAL_LinuxSpend(unsigned long);
+
+/**
+ * @brief Napredovanje simuliranog vremena do sledeceg prekida tajmera
+ *
+ * Menja vrednosti simuliranog AD konvertora i poziva HAL_PaddleHandler
+ * i HAL_TimerHandler.
+ */
+void HAL_LinuxTick(void);
+
+/**
+ * @brief Ukljucivanje i iskljucivanje emulatora kontrolera SSD1306
+ * @param 0 - bajtovi se samo broje (prazan transport), 1 - emulacija
+ */
+void HAL_LinuxSetEmulation(uint8_t);
+
+/**
+ * @brief Ukupan broj bajtova poslatih preko SPI magistrale
+ */
+unsigned long HAL_LinuxSPIBytes(void);
+
+#endif /* HAL_LINUX_H_ */
@@ -0,0 +1,234 @@
+/**
+ * @file host_main.c
+ * @brief Glavni program igrice za prevodjenje na racunaru (Linux)
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Program izvrsava iste zadatke kao main.c, ali se prekidi tajmera
+ * simuliraju pozivom HAL_LinuxTick, posle koga se zadaci izvrsavaju
+ * pozivom Sched_Dispatch, a polozaji igraca dolaze iz simuliranog AD
+ * konvertora. Sluzi za profilisanje i regresiono
+ * testiranje igrice bez ploce.
+ *
+ * Svaki frejm se proverava pomocu emulatora kontrolera SSD1306: sadrzaj
+ * emuliranog GDDRAM-a mora biti isti kao poslednji poslat frejm. Na
+ * kraju se ispisuje saobracaj na magistrali po frejmu i statistika
+ * zadataka rasporedjivaca.
+ *
+ * Ako je ukljucen zapis dogadjaja (TRACE_ENABLE), na kraju se zapis
+ * cuva u fajl koji se zadaje trecim argumentom (podrazumevano trace.bin).
+ *
+ * Upotreba: pong_host [broj_frejmova [ucestanost_SPI_takta_Hz [zapis.bin]]]
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hal.h"
+#include "asset.h"
+#include "event.h"
+#include "game.h"
+#include "hud.h"
+#include "input.h"
+#include "oled.h"
+#include "prng.h"
+#include "ssd1306_emu.h"
+#include "profile.h"
+#include "sched.h"
+#include "trace.h"
+
+/**
+ * Podrazumevani broj frejmova koji se simulira
+ */
+#define DEF_FRAMES 1000
+
+/**
+ * Broj odbiraka potenciometara procitanih od prethodnog slanja frejma
+ */
+static uint8_t samples = 0;
+
+
+/**
+ * @brief Obrada pritiska tastera, igra na racunaru pocinje odmah
+ */
+void HAL_ButtonHandler(void)
+{
+}
+
+/**
+ * @brief Obrada simuliranog prekida tajmera
+ */
+void HAL_TimerHandler(void)
+{
+	TRACE(TRACE_TIMER_TICK, 0);
+	Sched_Tick();
+}
+
+#if LATE_LATCH
+/**
+ * Broj odbiraka procitanih pri kasnom ocitavanju igraca u tekucem frejmu
+ */
+static uint8_t latched = 0;
+
+/**
+ * @brief Kasno ocitavanje igraca (SetBoardLatch)
+ * @param Adresa na koju se upisuje polozaj prvog igraca
+ * @param Adresa na koju se upisuje polozaj drugog igraca
+ *
+ * Pokrece se nova sekvenca AD konverzija, pa su polozaji sveziji od
+ * odbirka koji je stigao pre prekida tajmera.
+ */
+static void LatchBoards(unsigned int *pos1, unsigned int *pos2)
+{
+	HAL_SamplePaddles();
+	latched += Input_Update();
+	*pos1 = Input_Paddle(0);
+	*pos2 = Input_Paddle(1);
+}
+#endif
+
+/**
+ * @brief Zadatak citanja ulaza
+ */
+static void InputTask(void)
+{
+	samples += Input_Update();
+}
+
+/**
+ * @brief Zadatak fizike
+ */
+static void PhysicsTask(void)
+{
+	AdvanceClock(Sched_Elapsed());
+	UpdateGame(Input_Paddle(0), Input_Paddle(1));
+}
+
+/**
+ * @brief Zadatak slanja frejma
+ */
+static void FlushTask(void)
+{
+	FlushFrame();
+#if LATE_LATCH
+	samples += latched;
+	latched = 0;
+#endif
+	if(samples)
+		PROFILE_INPUT(Input_Stamp());
+	samples = 0;
+	HUD_TICK(Sched_Elapsed());
+}
+
+/**
+ * @brief Glavna funkcija
+ *
+ * Inicijalizuje simulirani hardver, prikazuje pocetni ekran i potom
+ * izvrsava zadati broj frejmova. Na kraju ispisuje broj poslatih
+ * bajtova preko SPI magistrale.
+ */
+int main(int argc, char **argv)
+{
+	long frames = argc > 1 ? atol(argv[1]) : DEF_FRAMES;
+	unsigned long clock = argc > 2 ? strtoul(argv[2], 0, 10) : EMU_DEF_SPI_CLOCK;
+	long f, mismatched = 0;
+	double max_wire = 0;
+	EMU_Stats st, tot;
+
+	HAL_Init();
+	OLED_Initialize();
+	Prng_Seed(HAL_Entropy());
+	HAL_EnableInterrupts();
+	EMU_SetSPIClock(clock);
+	OLED_PutAsset(start_screen);
+#if LATE_LATCH
+	SetBoardLatch(LatchBoards);
+#endif
+	Sched_Add(InputTask, 1, PROF_FRAME_BUDGET / 8, 1);
+	Sched_Add(PhysicsTask, 1, PROF_FRAME_BUDGET / 4, 1);
+	Sched_Add(RenderFrame, 1, PROF_FRAME_BUDGET / 2, 1);
+	Sched_Add(FlushTask, 1, PROF_FRAME_BUDGET - 1, 1);
+	EMU_FrameStats(&st);		// pocetni ekran se ne racuna
+	EMU_TotalStats(&tot);
+
+	for(f = 0; f < frames; f++)
+	{
+		HAL_LinuxTick();
+		Sched_Dispatch();
+		OLED_WaitIdle();
+
+		EMU_FrameStats(&st);
+		if(st.wire_us > max_wire)
+			max_wire = st.wire_us;
+		if(EMU_Compare(GetDisplayedFrame()))
+			mismatched++;
+	}
+
+	EMU_TotalStats(&st);
+	st.cmd_bytes -= tot.cmd_bytes;
+	st.data_bytes -= tot.data_bytes;
+	st.cs_toggles -= tot.cs_toggles;
+	st.dc_toggles -= tot.dc_toggles;
+	st.addr_cmds -= tot.addr_cmds;
+	st.wire_us -= tot.wire_us;
+
+	if(frames > 0)
+	{
+		printf("frames=%ld spi_clock=%lu\n", frames, clock);
+		printf("per_frame: cmd_bytes=%.1f data_bytes=%.1f cs_toggles=%.1f "
+				"dc_toggles=%.1f addr_cmds=%.1f wire_us=%.1f max_wire_us=%.1f\n",
+				(double)st.cmd_bytes / frames, (double)st.data_bytes / frames,
+				(double)st.cs_toggles / frames, (double)st.dc_toggles / frames,
+				(double)st.addr_cmds / frames, st.wire_us / frames, max_wire);
+		printf("mismatched_frames=%ld dropped_events=%u\n", mismatched, Event_Dropped());
+	}
+
+	if(frames > 0)
+	{
+		static const char *names[SCHED_MAX_TASKS] = {"input", "physics",
+				"render", "flush"};
+		SchedStats ss;
+		uint8_t k;
+		for(k = 0; k < SCHED_MAX_TASKS; k++)
+		{
+			Sched_Get(k, &ss);
+			printf("sched %-8s runs=%u missed=%u overruns=%u exec_min=%u "
+					"exec_max=%u exec_mean=%.1f jitter=%u\n", names[k],
+					ss.runs, ss.missed, ss.overruns, ss.runs ? ss.exec_min : 0,
+					ss.exec_max, ss.runs ? (double)ss.exec_sum / ss.runs : 0.0,
+					ss.runs ? ss.start_max - ss.start_min : 0);
+		}
+	}
+
+#if TRACE_ENABLE
+	{
+		FILE *tf = fopen(argc > 3 ? argv[3] : "trace.bin", "wb");
+		if(tf)
+		{
+			fwrite(&trace, sizeof(trace), 1, tf);
+			fclose(tf);
+		}
+	}
+#endif
+
+#if PROFILE_ENABLE
+	{
+		static const char *names[PROF_STAGES] = {"background", "erase", "nextstate",
+				"draw", "score", "wait", "send", "frame"};
+		ProfileStats ps;
+		uint8_t s;
+		for(s = 0; s < PROF_STAGES; s++)
+		{
+			Profile_Get(s, &ps);
+			printf("profile %-10s count=%u min=%u max=%u mean=%.1f\n", names[s],
+					ps.count, ps.min, ps.max, ps.count ? (double)ps.sum / ps.count : 0.0);
+		}
+		Profile_GetLatency(&ps);
+		printf("profile %-10s count=%u min=%u max=%u mean=%.1f\n", "latency",
+				ps.count, ps.min, ps.max, ps.count ? (double)ps.sum / ps.count : 0.0);
+	}
+#endif
+	return mismatched ? 1 : 0;
+}
+
+#endif /* __MSP430__ */
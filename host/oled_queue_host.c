@@ -0,0 +1,120 @@
+/**
+ * @file oled_queue_host.c
+ * @brief Zamenski transport reda deskriptora za prevodjenje na racunaru
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Bajtovi se salju preko simulirane SPI magistrale (hal_linux.c) i
+ * upisuju u memorijski zapis zajedno sa vrednoscu DC signala.
+ * Transport ne radi u pozadini: jedan deskriptor
+ * se salje pri svakom pozivu OLEDQ_TransportWait ili OLEDQ_HostStep, pa
+ * je redosled dogadjaja potpuno odredjen.
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include "hal.h"
+#include "oled_queue.h"
+#include "oled_queue_host.h"
+#include "trace.h"
+
+/**
+ * Zapis poslatih bajtova i vrednosti DC signala
+ */
+static uint8_t log_byte[OLEDQ_HOST_LOG_SIZE];
+static uint8_t log_dc[OLEDQ_HOST_LOG_SIZE];
+static unsigned long log_len = 0;
+
+/**
+ * Indikator da je transport pokrenut
+ */
+static uint8_t running = 0;
+
+/**
+ * @brief Pokretanje transporta ako trenutno ne salje
+ */
+void OLEDQ_TransportKick(void)
+{
+	if(!running && OLEDQ_Current())
+	{
+		running = 1;
+		TRACE(TRACE_SPI_START, 1);
+		HAL_CS_LOW();
+	}
+}
+
+/**
+ * @brief Slanje jednog deskriptora dok se ceka na transport
+ */
+void OLEDQ_TransportWait(void)
+{
+	OLEDQ_HostStep();
+}
+
+/**
+ * @brief Slanje jednog deskriptora iz reda
+ * @return 1 ako je deskriptor poslat, 0 ako je transport neaktivan
+ */
+uint8_t OLEDQ_HostStep(void)
+{
+	const OLEDQ_Desc *d = OLEDQ_Current();
+	unsigned int i;
+
+	if(!running || !d)
+		return 0;
+
+	if(d->dc == OLEDQ_DATA)
+		HAL_DC_HIGH();
+	else
+		HAL_DC_LOW();
+
+	for(i = 0; i < d->len; i++)
+	{
+		HAL_SPI_WRITE(d->buf[i]);
+		if(log_len < OLEDQ_HOST_LOG_SIZE)
+		{
+			log_byte[log_len] = d->buf[i];
+			log_dc[log_len] = d->dc;
+		}
+		log_len++;
+	}
+
+	if(!OLEDQ_Advance())
+	{
+		HAL_CS_HIGH();
+		running = 0;
+		TRACE(TRACE_SPI_END, 1);
+	}
+	return 1;
+}
+
+/**
+ * @brief Broj bajtova poslatih od poslednjeg brisanja zapisa
+ */
+unsigned long OLEDQ_HostLogLength(void)
+{
+	return log_len;
+}
+
+/**
+ * @brief Ocitavanje jednog bajta iz zapisa
+ * @param Redni broj bajta
+ * @param Adresa na koju se upisuje vrednost DC signala, moze biti 0
+ * @return Vrednost bajta
+ */
+uint8_t OLEDQ_HostLogByte(unsigned long idx, uint8_t *dc)
+{
+	if(idx >= OLEDQ_HOST_LOG_SIZE)
+		return 0;
+	if(dc)
+		*dc = log_dc[idx];
+	return log_byte[idx];
+}
+
+/**
+ * @brief Brisanje zapisa
+ */
+void OLEDQ_HostLogClear(void)
+{
+	log_len = 0;
+}
+
+#endif /* __MSP430__ */
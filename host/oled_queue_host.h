@@ -0,0 +1,41 @@
+/**
+ * @file oled_queue_host.h
+ * @brief Deklaracija zamenskog transporta reda deskriptora za racunar
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ */
+#ifndef OLED_QUEUE_HOST_H_
+#define OLED_QUEUE_HOST_H_
+
+#include <stdint.h>
+
+/**
+ * Najveci broj bajtova koji se pamti u zapisu
+ */
+#define OLEDQ_HOST_LOG_SIZE 4096
+
+/**
+ * @brief Slanje jednog deskriptora iz reda
+ * @return 1 ako je deskriptor poslat, 0 ako je transport neaktivan
+ */
+uint8_t OLEDQ_HostStep(void);
+
+/**
+ * @brief Broj bajtova poslatih od poslednjeg brisanja zapisa
+ */
+unsigned long OLEDQ_HostLogLength(void);
+
+/**
+ * @brief Ocitavanje jednog bajta iz zapisa
+ * @param Redni broj bajta
+ * @param Adresa na koju se upisuje vrednost DC signala, moze biti 0
+ * @return Vrednost bajta
+ */
+uint8_t OLEDQ_HostLogByte(unsigned long, uint8_t *);
+
+/**
+ * @brief Brisanje zapisa
+ */
+void OLEDQ_HostLogClear(void);
+
+#endif /* OLED_QUEUE_HOST_H_ */
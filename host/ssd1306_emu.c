@@ -0,0 +1,373 @@
+/**
+ * @file ssd1306_emu.c
+ * @brief Implementacija emulatora kontrolera SSD1306 za prevodjenje na racunaru
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Podrzani su sva tri rezima adresiranja (horizontalni, vertikalni i
+ * Page Addressing), komande sa argumentima i komande za skrolovanje.
+ * Komande koje ne uticu na sadrzaj GDDRAM-a se samo dekodiraju, da bi
+ * se ispravno prepoznali njihovi argumenti.
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <string.h>
+
+#include "oled.h"
+#include "ssd1306_emu.h"
+
+/**
+ * Pomeraj kolone: displej od 96 kolona je povezan na kolone 32 - 127
+ */
+#define EMU_COLUMN_OFFSET 32
+
+/**
+ * Rezimi adresiranja (argument komande SSD1306_MEMORYMODE)
+ */
+#define MODE_HORIZONTAL 0
+#define MODE_VERTICAL   1
+#define MODE_PAGE       2
+
+/**
+ * Sadrzaj GDDRAM-a
+ */
+static uint8_t gddram[EMU_PAGES][EMU_COLUMNS];
+
+/**
+ * Stanje adresiranja
+ */
+static uint8_t mode;
+static uint8_t col, page;
+static uint8_t col_start, col_end, page_start, page_end;
+static uint8_t page_col;	// pocetna kolona u Page Addressing rezimu
+
+/**
+ * Komanda koja ceka argumente, broj primljenih argumenata i sami argumenti
+ */
+static uint8_t pending_cmd, pending_len, pending_cnt;
+static uint8_t args[6];
+
+/**
+ * Podesavanja koja ne uticu na GDDRAM, ali se pamte
+ */
+static uint8_t multiplex = 63;
+static uint8_t scroll_active = 0;
+
+/**
+ * Stanje signala
+ */
+static uint8_t cs = 1, dc = 0;
+
+/**
+ * Ucestanost SPI takta i brojaci
+ */
+static unsigned long spi_clock = EMU_DEF_SPI_CLOCK;
+static EMU_Stats frame, total;
+
+/**
+ * @brief Broj argumenata komande
+ * @param Prvi bajt komande
+ */
+static uint8_t ArgCount(uint8_t c)
+{
+	switch(c)
+	{
+	case SSD1306_SETCONTRAST:
+	case SSD1306_MEMORYMODE:
+	case SSD1306_SETMULTIPLEX:
+	case SSD1306_SETDISPLAYOFFSET:
+	case SSD1306_SETDISPLAYCLOCKDIV:
+	case SSD1306_SETPRECHARGE:
+	case SSD1306_SETCOMPINS:
+	case SSD1306_SETVCOMDETECT:
+	case SSD1306_CHARGEPUMP:
+		return 1;
+	case SSD1306_COLUMNADDR:
+	case SSD1306_PAGEADDR:
+	case SSD1306_SET_VERTICAL_SCROLL_AREA:
+		return 2;
+	case SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL:
+	case SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL:
+		return 5;
+	case SSD1306_RIGHT_HORIZONTAL_SCROLL:
+	case SSD1306_LEFT_HORIZONTAL_SCROLL:
+		return 6;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Izvrsavanje komande cija su svi argumenti primljeni
+ * @param Prvi bajt komande
+ */
+static void Execute(uint8_t c)
+{
+	if(c <= 0x1F || (c >= 0xB0 && c <= 0xB7))
+	{
+		// Komande adresiranja stranice vaze samo u Page Addressing rezimu
+		if(mode != MODE_PAGE)
+			return;
+		if(c <= 0x0F)						// SETLOWCOLUMN
+			col = page_col = (page_col & 0xF0) | c;
+		else if(c <= 0x1F)					// SETHIGHCOLUMN
+			col = page_col = (page_col & 0x0F) | ((c & 0x07) << 4);
+		else								// Page Start Address
+			page = c & 0x07;
+		frame.addr_cmds++;
+		return;
+	}
+
+	switch(c)
+	{
+	case SSD1306_MEMORYMODE:
+		mode = args[0] & 0x03;
+		break;
+	case SSD1306_COLUMNADDR:
+		col_start = col = args[0] & 0x7F;
+		col_end = args[1] & 0x7F;
+		frame.addr_cmds++;
+		break;
+	case SSD1306_PAGEADDR:
+		page_start = page = args[0] & 0x07;
+		page_end = args[1] & 0x07;
+		frame.addr_cmds++;
+		break;
+	case SSD1306_SETMULTIPLEX:
+		multiplex = args[0] & 0x3F;
+		break;
+	case SSD1306_ACTIVATE_SCROLL:
+		scroll_active = 1;
+		break;
+	case SSD1306_DEACTIVATE_SCROLL:
+		scroll_active = 0;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Prijem komande ili argumenta komande
+ * @param Primljeni bajt
+ */
+static void Command(uint8_t b)
+{
+	frame.cmd_bytes++;
+	if(pending_cnt < pending_len)
+	{
+		args[pending_cnt++] = b;
+		if(pending_cnt == pending_len)
+			Execute(pending_cmd);
+		return;
+	}
+
+	pending_cmd = b;
+	pending_len = ArgCount(b);
+	pending_cnt = 0;
+	if(pending_len == 0)
+		Execute(b);
+}
+
+/**
+ * @brief Upis podatka u GDDRAM i pomeranje pokazivaca adrese
+ * @param Primljeni bajt
+ */
+static void Data(uint8_t b)
+{
+	frame.data_bytes++;
+	gddram[page][col] = b;
+
+	switch(mode)
+	{
+	case MODE_HORIZONTAL:
+		if(col++ >= col_end)
+		{
+			col = col_start;
+			page = page >= page_end ? page_start : page + 1;
+		}
+		break;
+	case MODE_VERTICAL:
+		if(page++ >= page_end)
+		{
+			page = page_start;
+			col = col >= col_end ? col_start : col + 1;
+		}
+		break;
+	default:	// MODE_PAGE: kolona se vraca na pocetnu, stranica ostaje ista
+		col = col >= EMU_COLUMNS - 1 ? page_col : col + 1;
+		break;
+	}
+}
+
+/**
+ * @brief Sabiranje brojaca
+ */
+static void Accumulate(EMU_Stats *dst, const EMU_Stats *src)
+{
+	dst->cmd_bytes += src->cmd_bytes;
+	dst->data_bytes += src->data_bytes;
+	dst->cs_toggles += src->cs_toggles;
+	dst->dc_toggles += src->dc_toggles;
+	dst->addr_cmds += src->addr_cmds;
+	dst->ignored_bytes += src->ignored_bytes;
+}
+
+/**
+ * @brief Procena vremena prenosa na osnovu broja bajtova
+ */
+static void WireTime(EMU_Stats *st)
+{
+	st->wire_us = (double)(st->cmd_bytes + st->data_bytes) * 8.0 * 1e6 / spi_clock;
+}
+
+/**
+ * @brief Vracanje emulatora u stanje posle reseta kontrolera
+ *
+ * Posle reseta kontroler je u Page Addressing rezimu, prozor pokriva
+ * ceo GDDRAM, a multipleks je 63. Sadrzaj GDDRAM-a nije definisan, pa
+ * se popunjava vrednoscu 0xA5 da bi neispisani delovi bili uocljivi.
+ */
+void EMU_Reset(void)
+{
+	memset(gddram, 0xA5, sizeof(gddram));
+	mode = MODE_PAGE;
+	col = page = page_col = 0;
+	col_start = 0; col_end = EMU_COLUMNS - 1;
+	page_start = 0; page_end = EMU_PAGES - 1;
+	pending_len = pending_cnt = 0;
+	multiplex = 63;
+	scroll_active = 0;
+	memset(&frame, 0, sizeof(frame));
+	memset(&total, 0, sizeof(total));
+}
+
+/**
+ * @brief Promena CS signala
+ * @param Nova vrednost (0 = aktivan)
+ */
+void EMU_SetCS(uint8_t val)
+{
+	val = val ? 1 : 0;
+	if(val != cs)
+		frame.cs_toggles++;
+	cs = val;
+}
+
+/**
+ * @brief Promena DC signala
+ * @param Nova vrednost (0 = komanda, 1 = podatak)
+ */
+void EMU_SetDC(uint8_t val)
+{
+	val = val ? 1 : 0;
+	if(val != dc)
+		frame.dc_toggles++;
+	dc = val;
+}
+
+/**
+ * @brief Prijem jednog bajta sa SPI magistrale
+ * @param Primljeni bajt
+ *
+ * Kontroler prihvata bajt samo dok je CS aktivan, a DC se ocitava na
+ * poslednjem taktu bajta.
+ */
+void EMU_Write(uint8_t b)
+{
+	if(cs)
+	{
+		frame.ignored_bytes++;
+		return;
+	}
+	if(dc)
+		Data(b);
+	else
+		Command(b);
+}
+
+/**
+ * @brief Podesavanje ucestanosti SPI takta za procenu vremena prenosa
+ * @param Ucestanost u Hz
+ */
+void EMU_SetSPIClock(unsigned long hz)
+{
+	if(hz)
+		spi_clock = hz;
+}
+
+/**
+ * @brief Ocitavanje i brisanje brojaca od pocetka frejma
+ * @param Adresa na koju se upisuju brojaci
+ */
+void EMU_FrameStats(EMU_Stats *st)
+{
+	WireTime(&frame);
+	*st = frame;
+	Accumulate(&total, &frame);
+	memset(&frame, 0, sizeof(frame));
+}
+
+/**
+ * @brief Ocitavanje ukupnih brojaca od reseta emulatora
+ * @param Adresa na koju se upisuju brojaci
+ *
+ * Obuhvata i brojace tekuceg frejma koji jos nisu ocitani.
+ */
+void EMU_TotalStats(EMU_Stats *st)
+{
+	*st = total;
+	Accumulate(st, &frame);
+	WireTime(st);
+}
+
+/**
+ * @brief Ocitavanje jednog bajta iz GDDRAM-a
+ * @param Strana
+ * @param Kolona kontrolera (0 - 127)
+ */
+uint8_t EMU_Read(uint8_t p, uint8_t c)
+{
+	return gddram[p & (EMU_PAGES - 1)][c & (EMU_COLUMNS - 1)];
+}
+
+/**
+ * @brief Poredjenje vidljivog dela GDDRAM-a sa slikom
+ * @param Slika u formatu koji koristi OLED_PutPicture
+ * @return Broj bajtova koji se razlikuju
+ *
+ * Porede se strane koje su vidljive pri podesenom multipleksu i
+ * kolone 32 - 127 na koje je povezan displej.
+ */
+unsigned int EMU_Compare(const uint8_t *pic)
+{
+	unsigned int diff = 0;
+	uint8_t p, c;
+	uint8_t pages = (multiplex + 1 + 7) / 8;
+	if(pages > OLED_BYTE_HEIGHT)
+		pages = OLED_BYTE_HEIGHT;
+
+	for(p = 0; p < pages; p++)
+		for(c = 0; c < OLED_WIDTH; c++)
+			if(gddram[p][c + EMU_COLUMN_OFFSET] != pic[p * OLED_WIDTH + c])
+				diff++;
+	return diff;
+}
+
+/**
+ * @brief Provera da li je skrolovanje aktivno
+ * @return 1 ako je poslata komanda SSD1306_ACTIVATE_SCROLL
+ */
+uint8_t EMU_ScrollActive(void)
+{
+	return scroll_active;
+}
+
+/**
+ * @brief Broj redova koji se prikazuju (multipleks + 1)
+ */
+uint8_t EMU_VisibleRows(void)
+{
+	return multiplex + 1;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,108 @@
+/**
+ * @file ssd1306_emu.h
+ * @brief Deklaracija emulatora kontrolera SSD1306 za prevodjenje na racunaru
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Emulator dekodira niz bajtova koje drajver salje preko SPI magistrale,
+ * zajedno sa stanjima CS i DC signala, i odrzava sopstveni GDDRAM.
+ * Uz to broji bajtove, promene CS i DC signala i komande adresiranja,
+ * na osnovu cega se procenjuje vreme prenosa na magistrali.
+ */
+#ifndef SSD1306_EMU_H_
+#define SSD1306_EMU_H_
+
+#include <stdint.h>
+
+/**
+ * Dimenzije GDDRAM-a kontrolera
+ */
+#define EMU_COLUMNS 128
+#define EMU_PAGES   8
+
+/**
+ * Podrazumevana ucestanost SPI takta (SMCLK / 1)
+ */
+#define EMU_DEF_SPI_CLOCK 1048576UL
+
+/**
+ * Brojaci saobracaja na magistrali
+ */
+typedef struct
+{
+	unsigned long cmd_bytes;		// bajtovi sa DC = 0
+	unsigned long data_bytes;		// bajtovi sa DC = 1
+	unsigned long cs_toggles;		// promene CS signala
+	unsigned long dc_toggles;		// promene DC signala
+	unsigned long addr_cmds;		// komande adresiranja strane i kolone
+	unsigned long ignored_bytes;	// bajtovi poslati dok je CS neaktivan
+	double wire_us;					// procenjeno vreme prenosa u mikrosekundama
+} EMU_Stats;
+
+/**
+ * @brief Vracanje emulatora u stanje posle reseta kontrolera
+ */
+void EMU_Reset(void);
+
+/**
+ * @brief Promena CS signala
+ * @param Nova vrednost (0 = aktivan)
+ */
+void EMU_SetCS(uint8_t);
+
+/**
+ * @brief Promena DC signala
+ * @param Nova vrednost (0 = komanda, 1 = podatak)
+ */
+void EMU_SetDC(uint8_t);
+
+/**
+ * @brief Prijem jednog bajta sa SPI magistrale
+ * @param Primljeni bajt
+ */
+void EMU_Write(uint8_t);
+
+/**
+ * @brief Podesavanje ucestanosti SPI takta za procenu vremena prenosa
+ * @param Ucestanost u Hz
+ */
+void EMU_SetSPIClock(unsigned long);
+
+/**
+ * @brief Ocitavanje i brisanje brojaca od pocetka frejma
+ * @param Adresa na koju se upisuju brojaci
+ */
+void EMU_FrameStats(EMU_Stats *);
+
+/**
+ * @brief Ocitavanje ukupnih brojaca od reseta emulatora
+ * @param Adresa na koju se upisuju brojaci
+ */
+void EMU_TotalStats(EMU_Stats *);
+
+/**
+ * @brief Ocitavanje jednog bajta iz GDDRAM-a
+ * @param Strana
+ * @param Kolona kontrolera (0 - 127)
+ */
+uint8_t EMU_Read(uint8_t, uint8_t);
+
+/**
+ * @brief Poredjenje vidljivog dela GDDRAM-a sa slikom
+ * @param Slika u formatu koji koristi OLED_PutPicture
+ * @return Broj bajtova koji se razlikuju
+ */
+unsigned int EMU_Compare(const uint8_t *);
+
+/**
+ * @brief Provera da li je skrolovanje aktivno
+ * @return 1 ako je poslata komanda SSD1306_ACTIVATE_SCROLL
+ */
+uint8_t EMU_ScrollActive(void);
+
+/**
+ * @brief Broj redova koji se prikazuju (multipleks + 1)
+ */
+uint8_t EMU_VisibleRows(void);
+
+#endif /* SSD1306_EMU_H_ */
@@ -0,0 +1,160 @@
+/**
+ * @file test_arith.c
+ * @brief Provera funkcija iz arith.c prema operatorima / i %
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Arith_Div i Arith_Mod se proveravaju za svaki 16-bitni deljenik sa
+ * deliocima koje program koristi (DIVISORS), a za svaki delilac od 2
+ * do 65535 na granicama: za sve umnoske delioca, jedan manje i jedan
+ * vise, i za najvece deljenike. Arith_ModMersenne se proverava za sve
+ * k od 2 do 16, a Arith_Frac prema (num << bits) / den za sve
+ * brojioce sa imeniocima do FRAC_DEN_FULL (brzina loptice u game.c
+ * je najvise 768) i na granicama za imenioce do 32767, za sve bits od
+ * 0 do 15.
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include "arith.h"
+#include "check.h"
+
+/**
+ * Delioci sa kojima program poziva ARITH_DIV i ARITH_MOD
+ * (text.c: 10, game.c: 100)
+ */
+static const uint16_t DIVISORS[] = { 10, 100 };
+
+/**
+ * Imenioci za koje se Arith_Frac proverava za sve brojioce
+ */
+#define FRAC_DEN_FULL 1024
+
+/**
+ * @brief Poredjenje rezultata sa ocekivanim
+ * @param Ime funkcije
+ * @param Prvi argument
+ * @param Drugi argument
+ * @param Treci argument
+ * @param Rezultat
+ * @param Ocekivani rezultat
+ */
+static void Check(const char *fn, unsigned long a, unsigned long b,
+		unsigned long c, unsigned long got, unsigned long want)
+{
+	Check_True(got == want, "%s(%lu, %lu, %lu) = %lu umesto %lu",
+			fn, a, b, c, got, want);
+}
+
+/**
+ * @brief Provera Arith_Div i Arith_Mod za jedan deljenik i delilac
+ * @param Deljenik
+ * @param Delilac
+ */
+static void CheckDiv(uint16_t x, uint16_t d)
+{
+	uint16_t r = ARITH_RECIP(d);
+
+	Check("Arith_Div", x, d, r, Arith_Div(x, d, r), x / d);
+	Check("Arith_Mod", x, d, r, Arith_Mod(x, d, r), x % d);
+}
+
+/**
+ * @brief Provera deljenja deliocima iz programa i na granicama
+ */
+static void TestDiv(void)
+{
+	unsigned long x, d, k;
+
+	for(k = 0; k < sizeof(DIVISORS) / sizeof(DIVISORS[0]); k++)
+		for(x = 0; x <= 0xFFFF; x++)
+		{
+			CheckDiv(x, DIVISORS[k]);
+			Check("ARITH_DIV", x, DIVISORS[k], 0,
+					ARITH_DIV(x, DIVISORS[k]), x / DIVISORS[k]);
+			Check("ARITH_MOD", x, DIVISORS[k], 0,
+					ARITH_MOD(x, DIVISORS[k]), x % DIVISORS[k]);
+		}
+
+	for(d = 2; d <= 0xFFFF; d++)
+	{
+		for(k = 0; k <= 0xFFFF; k += d)
+		{
+			CheckDiv(k, d);
+			if(k)
+				CheckDiv(k - 1, d);
+			if(k < 0xFFFF)
+				CheckDiv(k + 1, d);
+		}
+		for(x = 0xFFFF - 2; x <= 0xFFFF; x++)
+			CheckDiv(x, d);
+	}
+}
+
+/**
+ * @brief Provera ostatka deljenja sa 2^k - 1
+ */
+static void TestMersenne(void)
+{
+	static const uint32_t big[] = {
+		0x000FFFFFUL, 0x00FFFFFFUL, 0x7FFFFFFFUL, 0x80000000UL,
+		0xFFFEFFFFUL, 0xFFFFFFFEUL, 0xFFFFFFFFUL
+	};
+	unsigned long x, k, j;
+
+	for(k = 2; k <= 16; k++)
+	{
+		unsigned long m = (1UL << k) - 1;
+
+		for(x = 0; x < (1UL << 20); x++)
+			Check("Arith_ModMersenne", x, k, 0, Arith_ModMersenne(x, k), x % m);
+		for(j = 0; j < sizeof(big) / sizeof(big[0]); j++)
+			Check("Arith_ModMersenne", big[j], k, 0,
+					Arith_ModMersenne(big[j], k), big[j] % m);
+	}
+}
+
+/**
+ * @brief Provera Arith_Frac za jedan brojilac, imenilac i broj bitova
+ * @param Brojilac
+ * @param Imenilac
+ * @param Broj bitova iza zareza
+ */
+static void CheckFrac(uint16_t num, uint16_t den, uint8_t bits)
+{
+	Check("Arith_Frac", num, den, bits, Arith_Frac(num, den, bits),
+			((uint32_t)num << bits) / den);
+}
+
+/**
+ * @brief Provera razlomka prema deljenju
+ */
+static void TestFrac(void)
+{
+	unsigned int num, den, bits;
+
+	for(bits = 0; bits < 16; bits++)
+	{
+		for(den = 1; den <= FRAC_DEN_FULL; den++)
+			for(num = 0; num <= den; num++)
+				CheckFrac(num, den, bits);
+		for(den = FRAC_DEN_FULL + 1; den <= 32767; den++)
+		{
+			CheckFrac(0, den, bits);
+			CheckFrac(1, den, bits);
+			CheckFrac(den / 2, den, bits);
+			CheckFrac(den / 2 + 1, den, bits);
+			CheckFrac(den - 1, den, bits);
+			CheckFrac(den, den, bits);
+		}
+	}
+}
+
+int main(void)
+{
+	TestDiv();
+	TestMersenne();
+	TestFrac();
+
+	return Check_Done("test_arith");
+}
+
+#endif /* __MSP430__ */
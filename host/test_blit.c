@@ -0,0 +1,217 @@
+/**
+ * @file test_blit.c
+ * @brief Provera funkcija iz blit.c prema obradi bajt po bajt
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Svaka funkcija se poziva za svaki pomeraj i svaku duzinu od 0 do
+ * IMAGE_SIZE unutar bafera slike, sa odredistem i izvorom na parnoj i
+ * neparnoj adresi u svim kombinacijama. Rezultat se poredi sa istom
+ * operacijom uradjenom pomocu memcpy, memset ili petlje po bajtovima, i
+ * to ceo bafer sa po cetiri zastitna bajta sa obe strane, pa se vidi i
+ * upis van zadatog niza.
+ *
+ * Za Blit_Same se za svaki pomeraj i duzinu proverava razlika na
+ * pocetku, sredini i kraju niza i razlika jedan i dva bajta posle niza
+ * (da se vidi citanje van niza); za pomeraje 0 do 3 se razlika
+ * postavlja na svaki bajt niza.
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <string.h>
+
+#include "blit.h"
+#include "check.h"
+
+/**
+ * Broj zastitnih bajtova pre i posle bafera slike
+ */
+#define GUARD 4
+
+/**
+ * Velicina bafera sa zastitnim bajtovima (paran broj)
+ */
+#define BUF_SIZE (IMAGE_SIZE + 2 * GUARD)
+
+/**
+ * Bafer poravnat na rec, kao BlitImage
+ */
+typedef union
+{
+	uint8_t b[BUF_SIZE];
+	BlitWord w[BUF_SIZE / 2];
+} TestBuf;
+
+/**
+ * Odrediste, ocekivani rezultat, izvor i pocetni sadrzaj odredista
+ */
+static TestBuf dst, ref, src, init;
+
+/**
+ * @brief Popunjavanje bafera pseudoslucajnim bajtovima
+ * @param Bafer
+ * @param Pocetna vrednost
+ */
+static void Pattern(uint8_t *p, uint16_t s)
+{
+	unsigned int k;
+
+	for(k = 0; k < BUF_SIZE; k++)
+	{
+		s = s * 25173 + 13849;
+		p[k] = s >> 8;
+	}
+}
+
+/**
+ * @brief Poredjenje odredista sa ocekivanim rezultatom
+ * @param Ime funkcije
+ * @param Parnost odredista
+ * @param Parnost izvora
+ * @param Pomeraj
+ * @param Duzina
+ */
+static void Check(const char *fn, unsigned int dp, unsigned int sp,
+		unsigned int off, unsigned int len)
+{
+	Check_True(memcmp(dst.b, ref.b, BUF_SIZE) == 0,
+			"%s: dst %u src %u pomeraj %u duzina %u", fn, dp, sp, off, len);
+}
+
+/**
+ * @brief Vracanje odredista i ocekivanog rezultata u pocetno stanje
+ */
+static void Reset(void)
+{
+	memcpy(dst.b, init.b, BUF_SIZE);
+	memcpy(ref.b, init.b, BUF_SIZE);
+}
+
+/**
+ * @brief Provera Blit_Copy za sve parnosti, pomeraje i duzine
+ */
+static void TestCopy(void)
+{
+	unsigned int dp, sp, off, len;
+
+	for(dp = 0; dp < 2; dp++)
+		for(sp = 0; sp < 2; sp++)
+			for(off = 0; off + dp <= IMAGE_SIZE; off++)
+				for(len = 0; off + dp + len <= IMAGE_SIZE; len++)
+				{
+					uint8_t *d = dst.b + GUARD + dp + off;
+					const uint8_t *s = src.b + GUARD + sp + off;
+
+					Reset();
+					memcpy(ref.b + GUARD + dp + off, s, len);
+					Blit_Copy(d, s, len);
+					Check("Blit_Copy", dp, sp, off, len);
+				}
+}
+
+/**
+ * @brief Provera Blit_Fill, Blit_Mask i Blit_Xor za sve pomeraje i duzine
+ */
+static void TestFill(void)
+{
+	static const uint8_t fill[] = { 0x00, 0xFF, 0x5A };
+	static const uint8_t mask[][2] = {
+		{ 0xFF, 0x00 }, { 0x0F, 0xA0 }, { 0x00, 0x5A }, { 0xA5, 0x18 }
+	};
+	static const uint8_t xor[] = { 0xFF, 0x3C };
+	unsigned int dp, off, len, k, v;
+
+	for(dp = 0; dp < 2; dp++)
+		for(off = 0; off + dp <= IMAGE_SIZE; off++)
+			for(len = 0; off + dp + len <= IMAGE_SIZE; len++)
+			{
+				uint8_t *d = dst.b + GUARD + dp + off;
+				uint8_t *r = ref.b + GUARD + dp + off;
+
+				for(v = 0; v < sizeof(fill); v++)
+				{
+					Reset();
+					memset(r, fill[v], len);
+					Blit_Fill(d, fill[v], len);
+					Check("Blit_Fill", dp, dp, off, len);
+				}
+				for(v = 0; v < sizeof(mask) / sizeof(mask[0]); v++)
+				{
+					Reset();
+					for(k = 0; k < len; k++)
+						r[k] = (r[k] & mask[v][0]) | mask[v][1];
+					Blit_Mask(d, mask[v][0], mask[v][1], len);
+					Check("Blit_Mask", dp, dp, off, len);
+				}
+				for(v = 0; v < sizeof(xor); v++)
+				{
+					Reset();
+					for(k = 0; k < len; k++)
+						r[k] ^= xor[v];
+					Blit_Xor(d, xor[v], len);
+					Check("Blit_Xor", dp, dp, off, len);
+				}
+			}
+}
+
+/**
+ * @brief Provera Blit_Same sa razlikom na zadatom mestu
+ * @param Parnost prvog niza
+ * @param Parnost drugog niza
+ * @param Pomeraj
+ * @param Duzina
+ * @param Mesto razlike od pocetka niza (najvise duzina + 1)
+ */
+static void CheckSame(unsigned int dp, unsigned int sp, unsigned int off,
+		unsigned int len, unsigned int diff)
+{
+	const uint8_t *a = src.b + GUARD + dp + off;
+	uint8_t *b = dst.b + GUARD + sp + off;
+	unsigned int got, k;
+
+	memcpy(b, a, len + 2);
+	b[diff] = a[diff] ^ 0x10;
+	for(k = 0; k < len && a[k] == b[k]; k++)
+		;
+	got = Blit_Same(a, b, len);
+	Check_True(got == k, "Blit_Same: a %u b %u pomeraj %u duzina %u razlika %u:"
+			" %u umesto %u", dp, sp, off, len, diff, got, k);
+}
+
+/**
+ * @brief Provera Blit_Same za sve parnosti, pomeraje i duzine
+ */
+static void TestSame(void)
+{
+	unsigned int dp, sp, off, len, k;
+
+	for(dp = 0; dp < 2; dp++)
+		for(sp = 0; sp < 2; sp++)
+			for(off = 0; off <= IMAGE_SIZE; off++)
+				for(len = 0; off + len <= IMAGE_SIZE; len++)
+				{
+					CheckSame(dp, sp, off, len, len);
+					CheckSame(dp, sp, off, len, len + 1);
+					CheckSame(dp, sp, off, len, 0);
+					CheckSame(dp, sp, off, len, len / 2);
+					if(len)
+						CheckSame(dp, sp, off, len, len - 1);
+					if(off < 4)
+						for(k = 1; k < len; k++)
+							CheckSame(dp, sp, off, len, k);
+				}
+}
+
+int main(void)
+{
+	Pattern(src.b, 1);
+	Pattern(init.b, 2);
+
+	TestCopy();
+	TestFill();
+	Pattern(dst.b, 3);
+	TestSame();
+
+	return Check_Done("test_blit");
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,207 @@
+/**
+ * @file test_input.c
+ * @brief Provera obrade ulaza sa potenciometara (input.c) sintetickim signalom
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Odbirci se predaju kao iz prekidne rutine AD konvertora
+ * (HAL_PaddleHandler), po jedan par po frejmu, a posle svakog frejma se
+ * poziva Input_Update. Proverava se:
+ *  - sum: za svaku mirnu vrednost AD konvertora uz sum od najvise
+ *    +-NOISE jedinica polozaj igraca se ne menja
+ *  - pun hod: skok sa jednog kraja opsega na drugi se prati u jednom
+ *    frejmu
+ *  - pomeranje za jedan polozaj: skok sa sredine jednog polozaja na
+ *    sredinu susednog se prati posle MOVE_FRAMES frejmova, u oba smera
+ *  - podesavanje opsega: neispravan opseg se odbacuje i preslikavanje
+ *    ostaje isto, a najuzi ispravan opseg daje pun hod
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include "hal.h"
+#include "input.h"
+#include "check.h"
+
+/**
+ * Broj frejmova posle kojih se prati pomeranje za jedan polozaj. Polozaj
+ * je sirok oko 124 jedinice; sa INPUT_IIR_SHIFT = 1 filtrirana vrednost
+ * posle prvog frejma predje pola puta (62), sto je manje od polovine
+ * polozaja uvecane za INPUT_HYST (78), a posle drugog tri cetvrtine (93)
+ */
+#define MOVE_FRAMES 2
+
+/**
+ * Najveci sum u jedinicama AD konvertora (kao na racunaru, hal_linux.c)
+ */
+#define NOISE 8
+
+/**
+ * Broj frejmova sa sumom za svaku mirnu vrednost
+ */
+#define NOISE_FRAMES 64
+
+/**
+ * @brief Obrada simuliranog prekida tajmera (ne koristi se)
+ */
+void HAL_TimerHandler(void)
+{
+}
+
+/**
+ * @brief Obrada pritiska tastera (ne koristi se)
+ */
+void HAL_ButtonHandler(void)
+{
+}
+
+/**
+ * @brief Evidentiranje jedne provere
+ * @param Uslov koji mora da vazi
+ * @param Opis provere
+ * @param Vrednost AD konvertora
+ * @param Polozaj
+ */
+static void Check(int ok, const char *what, unsigned int v, unsigned int pos)
+{
+	Check_True(ok, "%s: vrednost %u, polozaj %u", what, v, pos);
+}
+
+/**
+ * @brief Jedan frejm: sekvenca AD konverzija i Input_Update
+ * @param Vrednost za oba potenciometra
+ * @return Polozaj prvog igraca (drugi mora biti isti)
+ */
+static unsigned int Frame(unsigned int v)
+{
+	HAL_PaddleHandler(v, v);
+	Input_Update();
+	Check(Input_Paddle(1) == Input_Paddle(0), "igraci se razlikuju", v, Input_Paddle(1));
+	return Input_Paddle(0);
+}
+
+/**
+ * @brief Vrednost AD konvertora na sredini polozaja
+ * @param Polozaj
+ * @return Vrednost za podrazumevani opseg 0 - HAL_ADC_MAX
+ */
+static unsigned int Center(unsigned int pos)
+{
+	return (unsigned int)(((2UL * pos + 1) * (HAL_ADC_MAX + 1)) / (2 * INPUT_POSITIONS));
+}
+
+/**
+ * @brief Sum ne pomera igraca
+ *
+ * Sum je niz vrednosti od -NOISE do +NOISE, sa najvecim skokovima
+ * izmedju krajeva opsega.
+ */
+static void TestNoise(void)
+{
+	unsigned int v, k, pos;
+	int n;
+
+	for(v = NOISE; v <= HAL_ADC_MAX - NOISE; v++)
+	{
+		Input_Reset();
+		pos = Frame(v);
+		for(k = 0; k < NOISE_FRAMES; k++)
+		{
+			n = (k & 1) ? NOISE : -NOISE;
+			if(k & 2)
+				n = n * (int)(k % (NOISE + 1)) / NOISE;
+			Check(Frame(v + n) == pos, "sum je pomerio igraca", v + n, pos);
+		}
+	}
+}
+
+/**
+ * @brief Skok sa jednog kraja opsega na drugi se prati u jednom frejmu
+ */
+static void TestSweep(void)
+{
+	Input_Reset();
+	Frame(0);
+	Check(Frame(HAL_ADC_MAX) == INPUT_POSITIONS - 1, "pun hod nadole", HAL_ADC_MAX, Input_Paddle(0));
+	Check(Frame(0) == 0, "pun hod nagore", 0, Input_Paddle(0));
+}
+
+/**
+ * @brief Pomeranje za jedan polozaj traje MOVE_FRAMES frejmova
+ * @param Pocetni polozaj
+ * @param Krajnji polozaj (susedni)
+ */
+static void CheckMove(unsigned int from, unsigned int to)
+{
+	unsigned int k;
+
+	Input_Reset();
+	Frame(Center(from));
+	for(k = 1; k < MOVE_FRAMES; k++)
+		Check(Frame(Center(to)) == from, "igrac se pomerio pre vremena", Center(to), Input_Paddle(0));
+	Check(Frame(Center(to)) == to, "igrac se nije pomerio", Center(to), Input_Paddle(0));
+}
+
+/**
+ * @brief Pomeranje za jedan polozaj, za sve polozaje u oba smera
+ */
+static void TestMove(void)
+{
+	unsigned int p;
+
+	for(p = 0; p + 1 < INPUT_POSITIONS; p++)
+	{
+		CheckMove(p, p + 1);
+		CheckMove(p + 1, p);
+	}
+}
+
+/**
+ * @brief Podesavanje opsega za oba igraca
+ * @param Vrednost za gornji polozaj
+ * @param Vrednost za donji polozaj
+ * @return Broj igraca za koje je opseg prihvacen
+ */
+static unsigned int Calibrate(unsigned int min, unsigned int max)
+{
+	return Input_Calibrate(0, min, max) + Input_Calibrate(1, min, max);
+}
+
+/**
+ * @brief Neispravan opseg ne menja preslikavanje
+ *
+ * Na kraju se vraca podrazumevani opseg 0 - HAL_ADC_MAX.
+ */
+static void TestCalibrate(void)
+{
+	unsigned int p;
+
+	Check(Calibrate(600, 500) == 0, "prihvacen obrnut opseg", 600, 500);
+	Check(Calibrate(500, 500 + INPUT_POSITIONS - 1) == 0, "prihvacen preuzak opseg",
+			500, 500 + INPUT_POSITIONS - 1);
+	for(p = 0; p < INPUT_POSITIONS; p++)
+	{
+		Input_Reset();
+		Check(Frame(Center(p)) == p, "odbacen opseg je promenio polozaj", Center(p), Input_Paddle(0));
+	}
+
+	Check(Calibrate(500, 500 + INPUT_POSITIONS) == 2, "odbacen najuzi opseg",
+			500, 500 + INPUT_POSITIONS);
+	Input_Reset();
+	Check(Frame(500) == 0, "najuzi opseg, gornji polozaj", 500, Input_Paddle(0));
+	Input_Reset();
+	Check(Frame(500 + INPUT_POSITIONS) == INPUT_POSITIONS - 1, "najuzi opseg, donji polozaj",
+			500 + INPUT_POSITIONS, Input_Paddle(0));
+
+	Check(Calibrate(0, HAL_ADC_MAX) == 2, "odbacen ceo opseg", 0, HAL_ADC_MAX);
+}
+
+int main(void)
+{
+	TestNoise();
+	TestSweep();
+	TestMove();
+	TestCalibrate();
+
+	return Check_Done("test_input");
+}
+
+#endif /* __MSP430__ */
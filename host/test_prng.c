@@ -0,0 +1,164 @@
+/**
+ * @file test_prng.c
+ * @brief Provera generatora pseudoslucajnih brojeva iz prng.c
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Proverava se:
+ *  - period: iz PRNG_SEED generator prolazi kroz svih 65535 vrednosti
+ *    razlicitih od nule pre nego sto se vrati u pocetno stanje
+ *  - pocetna vrednost nula: Prng_Seed(0) daje isti niz kao
+ *    Prng_Seed(PRNG_SEED), a generator nikad ne vraca nulu
+ *  - ravnomernost Prng_Range za opsege koje koristi igra: tokom celog
+ *    perioda se svaka vrednost pojavljuje 65535 / n puta, sa greskom
+ *    manjom od 1, a u kracim nizovima iz vise pocetnih stanja hi-kvadrat
+ *    statistika je ispod granice za verovatnocu 0,001
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include "oled.h"
+#include "prng.h"
+#include "check.h"
+
+/**
+ * Opseg za Prng_Range i granica hi-kvadrat statistike za n - 1 stepeni
+ * slobode pri verovatnoci 0,001
+ */
+typedef struct
+{
+	uint16_t n;
+	double chi2_max;
+} Range;
+
+/**
+ * Opsezi koje koristi igra (game.c, ServeBall): polozaj loptice po
+ * visini (8 * OLED_BYTE_HEIGHT - 2 za lopticu velicine 3), korak po
+ * visini (MAX_Y_STEP = 3) i smer (najvisi bit, kao Prng_Range(2))
+ */
+static const Range ranges[] = {
+	{ 8 * OLED_BYTE_HEIGHT - 2, 69.35 },
+	{ 3, 13.82 },
+	{ 2, 10.83 },
+};
+
+/**
+ * Pocetna stanja za hi-kvadrat proveru i broj izvlacenja po vrednosti
+ */
+static const uint16_t seeds[] = { PRNG_SEED, 1, 0x8000, 0xBEEF, 0xFFFF };
+#define DRAWS_PER_VALUE 200
+
+/**
+ * Najveci opseg u tabeli ranges
+ */
+#define MAX_RANGE 64
+
+/**
+ * Vrednosti koje su se pojavile tokom perioda
+ */
+static uint8_t seen[65536];
+
+/**
+ * @brief Provera perioda i vrednosti razlicitih od nule
+ */
+static void TestPeriod(void)
+{
+	uint16_t x;
+	long k, distinct = 0;
+
+	Prng_Seed(PRNG_SEED);
+	for(k = 1; k <= 65535; k++)
+	{
+		x = Prng_Next();
+		Check_True(x != 0, "Prng_Next vratio nulu posle koraka %ld", k);
+		if(!seen[x])
+			distinct++;
+		seen[x] = 1;
+		if(x == PRNG_SEED)
+			break;
+	}
+	Check_True(k == 65535, "period %ld umesto 65535", k);
+	Check_True(distinct == 65535, "%ld razlicitih vrednosti umesto 65535", distinct);
+}
+
+/**
+ * @brief Provera pocetne vrednosti nula
+ */
+static void TestZeroSeed(void)
+{
+	uint16_t a[16];
+	int k;
+
+	Prng_Seed(PRNG_SEED);
+	for(k = 0; k < 16; k++)
+		a[k] = Prng_Next();
+	Prng_Seed(0);
+	for(k = 0; k < 16; k++)
+		Check_True(Prng_Next() == a[k],
+				"Prng_Seed(0) se razlikuje od PRNG_SEED u koraku %d", k);
+}
+
+/**
+ * @brief Provera ravnomernosti Prng_Range za jedan opseg
+ * @param Opseg i granica hi-kvadrat statistike
+ */
+static void TestRange(const Range *r)
+{
+	unsigned long count[MAX_RANGE];
+	double expect, chi2, d;
+	unsigned int s, v;
+	long k, draws = (long)r->n * DRAWS_PER_VALUE;
+
+	Check_True(r->n <= MAX_RANGE, "opseg %u veci od MAX_RANGE", r->n);
+	if(r->n > MAX_RANGE)
+		return;
+
+	// Ceo period: broj pojavljivanja se razlikuje od 65535 / n manje od 1
+	for(v = 0; v < r->n; v++)
+		count[v] = 0;
+	Prng_Seed(PRNG_SEED);
+	for(k = 0; k < 65535; k++)
+	{
+		v = Prng_Range(r->n);
+		Check_True(v < r->n, "Prng_Range(%u) van opsega: %u", r->n, v);
+		if(v < r->n)
+			count[v]++;
+	}
+	expect = 65535.0 / r->n;
+	for(v = 0; v < r->n; v++)
+	{
+		d = (double)count[v] - expect;
+		Check_True(d > -1 && d < 1, "Prng_Range(%u): %u se u celom periodu"
+				" pojavljuje %lu puta", r->n, v, count[v]);
+	}
+
+	// Kraci nizovi: hi-kvadrat statistika
+	for(s = 0; s < sizeof(seeds) / sizeof(seeds[0]); s++)
+	{
+		for(v = 0; v < r->n; v++)
+			count[v] = 0;
+		Prng_Seed(seeds[s]);
+		for(k = 0; k < draws; k++)
+			count[Prng_Range(r->n)]++;
+		chi2 = 0;
+		for(v = 0; v < r->n; v++)
+		{
+			d = (double)count[v] - DRAWS_PER_VALUE;
+			chi2 += d * d / DRAWS_PER_VALUE;
+		}
+		Check_True(chi2 < r->chi2_max, "Prng_Range(%u), pocetna vrednost 0x%04X:"
+				" hi-kvadrat %.2f", r->n, seeds[s], chi2);
+	}
+}
+
+int main(void)
+{
+	unsigned int k;
+
+	TestPeriod();
+	TestZeroSeed();
+	for(k = 0; k < sizeof(ranges) / sizeof(ranges[0]); k++)
+		TestRange(&ranges[k]);
+
+	return Check_Done("test_prng");
+}
+
+#endif /* __MSP430__ */
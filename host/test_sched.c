@@ -0,0 +1,272 @@
+/**
+ * @file test_sched.c
+ * @brief Provera rasporedjivaca (sched.c) na simuliranom vremenu
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Prekide tajmera daje HAL_LinuxTick, a zadaci trose simulirano vreme
+ * pozivom HAL_LinuxSpend, pa su trajanja i redosled uvek isti. Zadaci:
+ *  - A: period 1; izvrsavanja LONG_RUN1 i LONG_RUN2 traju duze od dva
+ *    perioda, pa se dva prekida spajaju u jedno aktiviranje, a u
+ *    izvrsavanju ENABLE_RUN ukljucuje zadatak C
+ *  - B: period 3
+ *  - C: period 1, ukljucuje se iz zadatka A
+ *  - D: period 2, rok kraci od trajanja, pa je svako izvrsavanje
+ *    prekoracenje
+ *
+ * Proverava se da je zbir Sched_Elapsed svakog zadatka jednak broju
+ * prekida od njegovog ukljucenja (poravnatom na period), da se spojeni
+ * prekidi broje kao propusteni periodi, da zadatak sa periodom 3
+ * uvek dobija umnozak perioda, da zadatak ukljucen iz drugog zadatka
+ * pocinje od sledeceg prekida i da su trajanja tacno ona koja su
+ * zadaci potrosili.
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <stdio.h>
+
+#include "hal.h"
+#include "sched.h"
+#include "check.h"
+
+/**
+ * Broj taktova SMCLK izmedju dva prekida tajmera (hal_linux.c)
+ */
+#define TICK_CYCLES 32768UL
+
+/**
+ * Broj poziva HAL_LinuxTick
+ */
+#define LOOPS 60
+
+/**
+ * Trajanje zadataka u taktovima SMCLK; dugo izvrsavanje zadatka A
+ * prelazi dve granice perioda
+ */
+#define COST_A     100
+#define COST_LONG  (2 * TICK_CYCLES + COST_A)
+#define COST_B     200
+#define COST_C     150
+#define COST_D     100
+#define DEADLINE_D 50
+
+/**
+ * Izvrsavanja zadatka A koja traju dugo i izvrsavanje u kome ukljucuje C
+ */
+#define LONG_RUN1  20
+#define LONG_RUN2  40
+#define ENABLE_RUN 10
+
+/**
+ * Redni brojevi zadataka
+ */
+static uint8_t id_a, id_b, id_c, id_d;
+
+/**
+ * Broj prekida tajmera
+ */
+static unsigned int ticks = 0;
+
+/**
+ * Po zadatku: broj izvrsavanja, zbir Sched_Elapsed, prvi Sched_Elapsed
+ * i prekid pri poslednjem izvrsavanju
+ */
+typedef struct
+{
+	unsigned int runs;
+	unsigned int elapsed_sum;
+	unsigned int first;
+	unsigned int last_tick;
+} Seen;
+
+static Seen seen_a, seen_b, seen_c, seen_d;
+
+/**
+ * Prekid pri kome je zadatak C ukljucen
+ */
+static unsigned int enable_tick = 0;
+
+/**
+ * @brief Obrada simuliranog prekida tajmera
+ */
+void HAL_TimerHandler(void)
+{
+	ticks++;
+	Sched_Tick();
+}
+
+/**
+ * @brief Obrada pritiska tastera (ne koristi se)
+ */
+void HAL_ButtonHandler(void)
+{
+}
+
+/**
+ * @brief Obrada sekvence AD konverzija (ne koristi se)
+ */
+void HAL_PaddleHandler(unsigned int p1, unsigned int p2)
+{
+	(void)p1;
+	(void)p2;
+}
+
+/**
+ * @brief Evidentiranje jednog izvrsavanja zadatka
+ * @param Zapis zadatka
+ */
+static void Record(Seen *s)
+{
+	unsigned int e = Sched_Elapsed();
+
+	if(!s->runs)
+		s->first = e;
+	s->runs++;
+	s->elapsed_sum += e;
+	s->last_tick = ticks;
+}
+
+static void TaskA(void)
+{
+	Record(&seen_a);
+	if(seen_a.runs == ENABLE_RUN)
+	{
+		Sched_Enable(id_c, 1);
+		enable_tick = ticks;
+	}
+	HAL_LinuxSpend(seen_a.runs == LONG_RUN1 || seen_a.runs == LONG_RUN2 ? COST_LONG : COST_A);
+}
+
+static void TaskB(void)
+{
+	Record(&seen_b);
+	Check_True(Sched_Elapsed() % 3 == 0, "B: Sched_Elapsed %u nije umnozak perioda",
+			Sched_Elapsed());
+	HAL_LinuxSpend(COST_B);
+}
+
+static void TaskC(void)
+{
+	Record(&seen_c);
+	HAL_LinuxSpend(COST_C);
+}
+
+static void TaskD(void)
+{
+	Record(&seen_d);
+	HAL_LinuxSpend(COST_D);
+}
+
+/**
+ * @brief Provera statistike i zbira Sched_Elapsed jednog zadatka
+ * @param Ime zadatka
+ * @param Redni broj zadatka
+ * @param Zapis zadatka
+ * @param Period
+ * @param Ocekivani zbir Sched_Elapsed
+ */
+static void CheckTask(const char *name, uint8_t id, const Seen *s,
+		unsigned int period, unsigned int sum)
+{
+	SchedStats st;
+	char what[64];
+
+	Sched_Get(id, &st);
+	sprintf(what, "%s: broj izvrsavanja", name);
+	Check_Equal(what, st.runs, s->runs);
+	sprintf(what, "%s: zbir Sched_Elapsed", name);
+	Check_Equal(what, s->elapsed_sum, sum);
+	sprintf(what, "%s: propusteni periodi", name);
+	Check_Equal(what, st.missed, s->elapsed_sum / period - s->runs);
+}
+
+/**
+ * @brief Provera trajanja zadatka koji uvek trosi isto
+ * @param Ime zadatka
+ * @param Redni broj zadatka
+ * @param Trajanje
+ */
+static void CheckExec(const char *name, uint8_t id, unsigned int cost)
+{
+	SchedStats st;
+	char what[64];
+
+	Sched_Get(id, &st);
+	sprintf(what, "%s: najkrace trajanje", name);
+	Check_Equal(what, st.exec_min, cost);
+	sprintf(what, "%s: najduze trajanje", name);
+	Check_Equal(what, st.exec_max, cost);
+	sprintf(what, "%s: ukupno trajanje", name);
+	Check_Equal(what, st.exec_sum, (unsigned long)cost * st.runs);
+}
+
+int main(void)
+{
+	SchedStats st;
+	unsigned int k;
+
+	HAL_Init();
+	HAL_EnableInterrupts();
+	id_a = Sched_Add(TaskA, 1, 0xFFFF, 1);
+	id_b = Sched_Add(TaskB, 3, 0xFFFF, 1);
+	id_c = Sched_Add(TaskC, 1, 0xFFFF, 0);
+	id_d = Sched_Add(TaskD, 2, DEADLINE_D, 1);
+	Check_Equal("peti zadatak nije odbijen", Sched_Add(TaskD, 1, 0, 1), SCHED_NONE);
+
+	for(k = 0; k < LOOPS; k++)
+	{
+		HAL_LinuxTick();
+		Sched_Dispatch();
+		Check_Equal("drugi Sched_Dispatch bez prekida", Sched_Dispatch(), 0);
+	}
+
+	// Svako dugo izvrsavanje prelazi dve granice perioda, pa sledeci
+	// HAL_LinuxTick daje dva prekida odjednom
+	Check_Equal("broj prekida", ticks, LOOPS + 2);
+
+	// A je aktivan od prekida 0 i izvrsava se pri svakom pozivu
+	Check_Equal("A: broj izvrsavanja", seen_a.runs, LOOPS);
+	CheckTask("A", id_a, &seen_a, 1, ticks);
+	Sched_Get(id_a, &st);
+	Check_Equal("A: spojeni prekidi", st.missed, 2);
+
+	// B se aktivira u prekidima 1, 4, 7, ...; zbir je do poslednjeg
+	// takvog prekida, racunato od prekida -2
+	CheckTask("B", id_b, &seen_b, 3, (ticks + 2) / 3 * 3);
+	Check_Equal("B: prvi Sched_Elapsed", seen_b.first, 3);
+	CheckExec("B", id_b, COST_B);
+
+	// C pocinje od prekida posle onog u kome ga je A ukljucio
+	Check_Equal("C: ukljucen u prekidu", enable_tick, ENABLE_RUN);
+	CheckTask("C", id_c, &seen_c, 1, ticks - enable_tick);
+	Check_Equal("C: prvi Sched_Elapsed", seen_c.first, 1);
+	Sched_Get(id_c, &st);
+	Check_Equal("C: spojeni prekidi", st.missed, 2);
+	CheckExec("C", id_c, COST_C);
+
+	// D se aktivira u neparnim prekidima i uvek prekoraci rok
+	CheckTask("D", id_d, &seen_d, 2, (ticks + 1) / 2 * 2);
+	CheckExec("D", id_d, COST_D);
+	Sched_Get(id_d, &st);
+	Check_Equal("D: prekoracenja roka", st.overruns, st.runs);
+
+	// Iskljucen zadatak se ne izvrsava, a posle ponovnog ukljucenja
+	// vreme dok je bio iskljucen se ne broji kao propusteni periodi
+	Sched_Reset();
+	Sched_Enable(id_c, 0);
+	k = seen_c.runs;
+	HAL_LinuxTick();
+	Sched_Dispatch();
+	HAL_LinuxTick();
+	Sched_Dispatch();
+	Check_Equal("C: iskljucen zadatak se izvrsio", seen_c.runs, k);
+	Sched_Enable(id_c, 1);
+	HAL_LinuxTick();
+	Sched_Dispatch();
+	Sched_Get(id_c, &st);
+	Check_Equal("C: izvrsavanja posle ponovnog ukljucenja", st.runs, 1);
+	Check_Equal("C: propusteni periodi posle ponovnog ukljucenja", st.missed, 0);
+
+	return Check_Done("test_sched");
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,171 @@
+/**
+ * @file hud.c
+ * @brief Prikaz pokazatelja performansi preko terena
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Raspored u strani HUD_PAGE:
+ *  - levo:  FPS (2 cifre) i najduze trajanje frejma (3 cifre)
+ *  - desno: propusteni prekidi (2 cifre) i najvise bajtova po frejmu (3 cifre)
+ * Vrednosti vece od najvece koja staje u polje se prikazuju kao 9...9.
+ *
+ * Pokazatelji se ispisuju jednom u sekundi, zajedno sa FPS. Trajanje i
+ * broj bajtova su najveci u toj sekundi, bez frejma u kome je prikaz
+ * ispisan, pa ispis ne ulazi u vrednosti koje prikazuje.
+ */
+#include "hal.h"
+#include "hud.h"
+#include "oled.h"
+#include "sprite.h"
+#include "text.h"
+
+#if HUD_ENABLE
+
+/**
+ * Broj prekida tajmera u sekundi
+ */
+#define TICKS_PER_SEC (HAL_TIMER_HZ / HAL_TIMER_PERIOD)
+
+/**
+ * Pokazatelji koji se prikazuju
+ */
+#define HUD_FPS    0
+#define HUD_TICKS  1
+#define HUD_MISSED 2
+#define HUD_BYTES  3
+#define HUD_FIELDS 4
+
+/**
+ * Polja u strani HUD_PAGE
+ */
+static TextField field[HUD_FIELDS] = {
+	TEXT_FIELD(4,  8 * HUD_PAGE, 2, TEXT_RIGHT),
+	TEXT_FIELD(19, 8 * HUD_PAGE, 3, TEXT_RIGHT),
+	TEXT_FIELD(51, 8 * HUD_PAGE, 2, TEXT_RIGHT),
+	TEXT_FIELD(71, 8 * HUD_PAGE, 3, TEXT_RIGHT)
+};
+
+/**
+ * Vrednosti koje treba prikazati
+ */
+static unsigned int value[HUD_FIELDS];
+
+/**
+ * Brojaci za racunanje FPS
+ */
+static unsigned int sec_ticks = 0;
+static uint8_t sec_frames = 0;
+
+/**
+ * Najduze trajanje frejma i najvise bajtova po frejmu u tekucoj sekundi
+ */
+static unsigned int max_ticks = 0, max_bytes = 0;
+
+/**
+ * Indikator da se pokazatelji ispisuju pri sledecem HUD_Update i
+ * indikator da su ispisani u tekucem frejmu
+ */
+static uint8_t refresh = 1, drawn = 0;
+
+/**
+ * Vrednost brojaca Timera A na pocetku frejma
+ */
+static unsigned int frame_start;
+
+/**
+ * @brief Prijava prekida tajmera koji su se desili od prethodnog frejma
+ * @param Broj prekida (vise od 1 znaci da su neki propusteni)
+ *
+ * Svakih TICKS_PER_SEC prekida se FPS postavlja na broj frejmova
+ * iscrtanih u toj sekundi, preuzimaju se najvece vrednosti iz te
+ * sekunde i zahteva se ispis.
+ */
+void HUD_Tick(unsigned int ticks)
+{
+	if(ticks > 1)
+		value[HUD_MISSED] += ticks - 1;
+	sec_ticks += ticks;
+	if(sec_ticks >= TICKS_PER_SEC)
+	{
+		sec_ticks = 0;
+		value[HUD_FPS] = sec_frames;
+		value[HUD_TICKS] = max_ticks;
+		value[HUD_BYTES] = max_bytes;
+		sec_frames = 0;
+		max_ticks = max_bytes = 0;
+		refresh = 1;
+	}
+}
+
+/**
+ * @brief Pocetak frejma
+ */
+void HUD_FrameStart(void)
+{
+	frame_start = HAL_TIMER_COUNT();
+}
+
+/**
+ * @brief Kraj frejma
+ * @param Broj bajtova poslatih na OLED u ovom frejmu
+ *
+ * Brojac Timera A broji do HAL_TIMER_PERIOD u rezimu Up, pa se
+ * razlika racuna po modulu perioda. Frejm u kome je prikaz ispisan se
+ * broji za FPS, ali ne ulazi u najvece trajanje i broj bajtova.
+ */
+void HUD_FrameEnd(unsigned int bytes)
+{
+	unsigned int now = HAL_TIMER_COUNT();
+	unsigned int t = now >= frame_start ? now - frame_start
+			: now + HAL_TIMER_PERIOD - frame_start;
+
+	sec_frames++;
+	if(drawn)
+	{
+		drawn = 0;
+		return;
+	}
+	if(t > max_ticks)
+		max_ticks = t;
+	if(bytes > max_bytes)
+		max_bytes = bytes;
+}
+
+/**
+ * @brief Ispisivanje pokazatelja u staticni sloj, jednom u sekundi
+ *
+ * Ispisuju se samo polja cija se vrednost promenila od prethodnog
+ * ispisa (text.h), pa prikaz ne trosi vreme kada su vrednosti stabilne.
+ */
+void HUD_Update(void)
+{
+	uint8_t *layer = Sprite_StaticLayer();
+	TextSpan span;
+	uint8_t f, p;
+
+	if(!refresh)
+		return;
+	refresh = 0;
+
+	for(f = 0; f < HUD_FIELDS; f++)
+	{
+		if(!Text_Number(&field[f], value[f], layer, &span))
+			continue;
+		drawn = 1;
+		for(p = span.page; p < span.page + span.pages; p++)
+			Sprite_StaticChanged(p * OLED_WIDTH + span.col, span.len);
+	}
+}
+
+/**
+ * @brief Zahtev da se pri sledecem HUD_Update ispisu svi pokazatelji
+ */
+void HUD_Invalidate(void)
+{
+	uint8_t f;
+	for(f = 0; f < HUD_FIELDS; f++)
+		Text_Invalidate(&field[f]);
+	refresh = 1;
+}
+
+#endif /* HUD_ENABLE */
@@ -0,0 +1,94 @@
+/**
+ * @file hud.h
+ * @brief Prikaz pokazatelja performansi preko terena
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * U donjoj strani displeja se ispisuju: broj frejmova u sekundi, najduze
+ * trajanje frejma u taktovima Timera A, broj propustenih prekida tajmera
+ * i najveci broj bajtova poslatih na OLED u jednom frejmu, u poslednjoj
+ * sekundi. Cifre se upisuju u staticni sloj (sprite.h) jednom u sekundi,
+ * i to samo kada se neka vrednost promeni; frejm u kome se ispisuju se
+ * ne racuna u trajanje i broj bajtova.
+ * Prikaz se ukljucuje makroom HUD_ENABLE.
+ */
+#ifndef HUD_H_
+#define HUD_H_
+
+#include <stdint.h>
+
+#ifndef HUD_ENABLE
+#define HUD_ENABLE 0
+#endif
+
+/**
+ * Strana koju zauzima prikaz. Kolone igraca (1, 2, 93 i 94) i srednja
+ * linija (47 i 48) se ne menjaju.
+ */
+#define HUD_PAGE      4
+
+#if HUD_ENABLE
+
+/**
+ * Prekidi tajmera od prethodnog frejma
+ */
+#define HUD_TICK(n)				HUD_Tick(n)
+
+/**
+ * Pocetak frejma: pamti se stanje brojaca tajmera
+ */
+#define HUD_FRAME_START()		HUD_FrameStart()
+
+/**
+ * Kraj frejma: racuna se trajanje i pamti broj poslatih bajtova
+ */
+#define HUD_FRAME_END(bytes)	HUD_FrameEnd(bytes)
+
+/**
+ * Ispisivanje promenjenih pokazatelja u staticni sloj
+ */
+#define HUD_UPDATE()			HUD_Update()
+
+/**
+ * Staticni sloj je ponovo ucitan, pa se ispisuju svi pokazatelji
+ */
+#define HUD_INVALIDATE()		HUD_Invalidate()
+
+/**
+ * @brief Prijava prekida tajmera koji su se desili od prethodnog frejma
+ * @param Broj prekida (vise od 1 znaci da su neki propusteni)
+ */
+void HUD_Tick(unsigned int);
+
+/**
+ * @brief Pocetak frejma
+ */
+void HUD_FrameStart(void);
+
+/**
+ * @brief Kraj frejma
+ * @param Broj bajtova poslatih na OLED u ovom frejmu
+ */
+void HUD_FrameEnd(unsigned int);
+
+/**
+ * @brief Ispisivanje pokazatelja u staticni sloj, ako se neki promenio
+ */
+void HUD_Update(void);
+
+/**
+ * @brief Zahtev da se pri sledecem HUD_Update ispisu svi pokazatelji
+ */
+void HUD_Invalidate(void);
+
+#else
+
+#define HUD_TICK(n)
+#define HUD_FRAME_START()
+#define HUD_FRAME_END(bytes)
+#define HUD_UPDATE()
+#define HUD_INVALIDATE()
+
+#endif /* HUD_ENABLE */
+
+#endif /* HUD_H_ */
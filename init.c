@@ -4,13 +4,14 @@
  * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
  * @date 2016
  */
+#include "hal.h"
 #include "init.h"
 #include "oled.h"
 
 /**
- * Konstanta koja definise ucestanost koju koristi Timer A
+ * Period prekida Timera A u taktovima ACLK (HAL_TIMER_HZ)
  */
-#define OLED_REFRESH_FREQUENCY 1024
+#define OLED_REFRESH_FREQUENCY HAL_TIMER_PERIOD
 
 
 /**
@@ -18,35 +19,60 @@
  *
  * Funkcija koja konfigurise hardver AD konvertora.
  * Multipleksira odgovarajuce pinove tako da se koriste za AD konvertor.
- * Konfigurise AD konvertor da radi u rezimu Repeat Sequence of channels.
- * Koristi memorijske lokacije 0 i 1 za smestanje rezultata konverzije.
+ * Konfigurise AD konvertor da radi u rezimu Sequence of channels:
+ * memorijske lokacije se naizmenicno pune kanalima 14 (igrac 1) i 9
+ * (igrac 2), HAL_ADC_OVERSAMPLE puta. Sekvencu pokrece izlaz TA0.1
+ * (initTMRA), a prekid se dozvoljava samo za poslednju lokaciju, pa je
+ * jedan prekid po sekvenci.
  */
 void initADC(void)
 {
+	volatile uint8_t *mctl = &ADC12MCTL0;
+	uint8_t k;
+
 	/* multipleksiranje pinova */
 	P7SEL |= BIT6 + BIT7;
 
 	/* podesavanje AD konvertora */
 	ADC12CTL0 = ADC12ON + ADC12MSC;		/* koristi MSC */
-	ADC12CTL1 = ADC12SHS_1 + ADC12CONSEQ_1 + ADC12SHP; // Proveriti shs i conseq
-	ADC12MCTL0 = ADC12INCH_14;
-	ADC12MCTL1 = ADC12INCH_9;
-	ADC12IE |= ADC12IE0 + ADC12IE1;	/* dozvoli sve prekide */
+	ADC12CTL1 = ADC12SHS_1 + ADC12CONSEQ_1 + ADC12SHP;	/* TA0.1, jedna sekvenca */
+	for(k = 0; k < 2 * HAL_ADC_OVERSAMPLE; k += 2)
+	{
+		mctl[k] = ADC12INCH_14;
+		mctl[k + 1] = ADC12INCH_9;
+	}
+	mctl[2 * HAL_ADC_OVERSAMPLE - 1] |= ADC12EOS;
+	ADC12IE = 1 << (2 * HAL_ADC_OVERSAMPLE - 1);	/* samo kraj sekvence */
 	ADC12CTL0 |= ADC12ENC;		/* dozvoli konverziju */
-
 }
 
 /**
  * @brief Inicijalizacija tajmera A0
  *
- * Tajmer A0 se koristi za generisanje periodicnog prekida
- * na koji ce se osvezavati displej.
+ * Tajmer A0 broji taktove ACLK (HAL_TIMER_HZ = 32768 Hz) i koristi se
+ * za generisanje periodicnog prekida na koji ce se osvezavati displej,
+ * svakih HAL_TIMER_PERIOD taktova. Izlaz TA0.1 se postavlja HAL_ADC_LEAD
+ * taktova pre prekida i pokrece sekvencu AD konverzija, pa su vrednosti
+ * potenciometara sveze kada frejm pocne.
  */
 void initTMRA(void)
 {
     TA0CCTL0 = OUTMOD_4 + CCIE;		// outmod = toggle
     TA0CCR0 = OLED_REFRESH_FREQUENCY;
-    TA0CTL = TASSEL_1 + MC_1;	// SMCLK, up mode
+    TA0CCTL1 = OUTMOD_3;			// set na CCR1, reset na CCR0
+    TA0CCR1 = OLED_REFRESH_FREQUENCY - HAL_ADC_LEAD;
+    TA0CTL = TASSEL_1 + MC_1;	// ACLK, up mode
+}
+
+/**
+ * @brief Inicijalizacija slobodnog brojaca vremena (Tajmer A1)
+ *
+ * Tajmer A1 broji taktove SMCLK u kontinualnom rezimu i koristi se
+ * kao vremenska osnova za merenje trajanja (HAL_TIMESTAMP).
+ */
+void initTMRA1(void)
+{
+    TA1CTL = TASSEL_2 + MC_2 + TACLR;	// SMCLK, continuous mode
 }
 
 /**
@@ -88,6 +114,24 @@ void initMBUS1(void)
 
 }
 
+/**
+ * @brief Inicijalizacija DMA kanala za slanje podataka na OLED
+ *
+ * DMA kanal 0 prebacuje po jedan bajt iz memorije u predajni registar
+ * SPI B0 na svaki zahtev UCB0TXIFG (okidac 19). Adresa izvora i broj
+ * bajtova se postavljaju za svaki deskriptor iz reda za slanje.
+ */
+void initDMA(void)
+{
+	DMACTL0 = DMA0TSEL_19;		// UCB0TXIFG
+	__data16_write_addr((unsigned short)&DMA0DA, (unsigned long)&UCB0TXBUF);
+	DMA0CTL = DMADT_0			// jedan bajt po zahtevu
+			+ DMASRCINCR_3		// izvor se uvecava
+			+ DMADSTINCR_0		// odrediste je fiksno
+			+ DMASBDB			// bajt u bajt
+			+ DMAIE;			// prekid na kraju niza
+}
+
 /**
  * @brief Inicijalizacija tastera 4
  *
@@ -21,6 +21,11 @@ void initADC(void);
  */
 void initTMRA(void);
 
+/**
+ * @brief Inicijalizacija slobodnog brojaca vremena (Tajmer A1)
+ */
+void initTMRA1(void);
+
 /**
  * @brief Inicijalizacija SPI B0 hardvera
  */
@@ -31,6 +36,11 @@ void initSPIB(void);
  */
 void initMBUS1(void);
 
+/**
+ * @brief Inicijalizacija DMA kanala za slanje podataka na OLED
+ */
+void initDMA(void);
+
 /**
  * @brief Inicijalizacija tastera
  */
@@ -0,0 +1,241 @@
+/**
+ * @file input.c
+ * @brief Obrada ulaza sa potenciometara igraca
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ */
+#include "event.h"
+#include "hal.h"
+#include "input.h"
+
+/**
+ * Broj razlomljenih bitova stanja filtra
+ */
+#define IIR_FRAC 4
+
+/**
+ * Prag INPUT_SNAP u jedinicama stanja filtra
+ */
+#define SNAP ((uint16_t)INPUT_SNAP << IIR_FRAC)
+
+typedef char iir_fits_16_bits[(HAL_ADC_MAX << IIR_FRAC) <= 0xFFFF ? 1 : -1];
+
+/**
+ * Stanje obrade jednog potenciometra
+ */
+typedef struct
+{
+	uint16_t iir;		// filtrirana vrednost, IIR_FRAC bitova iza zareza
+	unsigned int min;	// vrednost za gornji polozaj
+	unsigned int max;	// vrednost za donji polozaj
+	uint16_t scale;		// INPUT_POSITIONS / (max - min + 1), Q0.16
+	unsigned int pos;	// trenutni polozaj igraca
+} InputChannel;
+
+/**
+ * Reciprocna vrednost opsega od n jedinica AD konvertora, Q0.16; staje
+ * u 16 bita samo za n > INPUT_POSITIONS
+ */
+#define SCALE(n) ((uint16_t)(65536UL * INPUT_POSITIONS / (n)))
+
+/**
+ * Stanje oba potenciometra; podrazumevano se koristi ceo opseg
+ * AD konvertora
+ */
+static InputChannel chan[2] = {
+	{0, 0, HAL_ADC_MAX, SCALE(HAL_ADC_MAX + 1UL), INPUT_POSITIONS / 2},
+	{0, 0, HAL_ADC_MAX, SCALE(HAL_ADC_MAX + 1UL), INPUT_POSITIONS / 2}
+};
+
+/**
+ * Maska kanala ciji filtar ima prethodnu vrednost
+ */
+static uint8_t primed = 0;
+
+/**
+ * Indikator da je taster pritisnut od poslednjeg Input_Reset
+ */
+static uint8_t button = 0;
+
+/**
+ * Vreme nastanka poslednjeg procitanog odbirka potenciometra
+ */
+static uint16_t stamp = 0;
+
+/**
+ * @brief Obrada zavrsene sekvence AD konverzija
+ * @param Vrednost za prvog igraca
+ * @param Vrednost za drugog igraca
+ *
+ * Poziva se iz prekidne rutine AD konvertora; odbirci se samo upisuju
+ * u red dogadjaja, a filtriraju se u Input_Update.
+ */
+void HAL_PaddleHandler(unsigned int p1, unsigned int p2)
+{
+	Event_Push(EVENT_PADDLE, 0, p1);
+	Event_Push(EVENT_PADDLE, 1, p2);
+}
+
+/**
+ * @brief Zaboravljanje prethodnih vrednosti
+ *
+ * Dogadjaji koji cekaju u redu se odbacuju.
+ */
+void Input_Reset(void)
+{
+	Event e;
+
+	while(Event_Pop(&e));
+	primed = 0;
+	button = 0;
+}
+
+/**
+ * @brief Podesavanje opsega vrednosti potenciometra
+ * @param Redni broj igraca (0 ili 1)
+ * @param Vrednost AD konvertora za gornji polozaj
+ * @param Vrednost AD konvertora za donji polozaj
+ * @return 0 ako je opseg neispravan i prethodni je zadrzan
+ *
+ * Opseg mora imati vise od INPUT_POSITIONS vrednosti, inace bi svaki
+ * polozaj bio uzi od jedne jedinice, a reciprocna vrednost ne bi stala
+ * u 16 bita. Ovo je jedino deljenje u obradi ulaza i izvrsava se samo
+ * pri podesavanju; po frejmu se mnozi sacuvanom reciprocnom vrednoscu.
+ */
+uint8_t Input_Calibrate(uint8_t ch, unsigned int min, unsigned int max)
+{
+	InputChannel *c = &chan[ch ? 1 : 0];
+
+	if(max < min || max - min < INPUT_POSITIONS)
+		return 0;
+
+	c->min = min;
+	c->max = max;
+	c->scale = SCALE(max - min + 1UL);
+	return 1;
+}
+
+/**
+ * @brief Preslikavanje vrednosti AD konvertora u polozaj igraca
+ * @param Stanje potenciometra
+ * @param Vrednost AD konvertora (moze biti van opsega min - max)
+ * @return Polozaj u opsegu 0 - INPUT_POSITIONS-1
+ */
+static unsigned int Map(const InputChannel *c, int v)
+{
+	unsigned int p;
+
+	if(v <= (int)c->min)
+		return 0;
+	if(v >= (int)c->max)
+		return INPUT_POSITIONS - 1;
+	p = (unsigned int)(((uint32_t)(v - c->min) * c->scale) >> 16);
+	return p < INPUT_POSITIONS ? p : INPUT_POSITIONS - 1;
+}
+
+/**
+ * @brief Filtriranje jedne vrednosti i azuriranje polozaja
+ * @param Redni broj igraca (0 ili 1)
+ * @param Nova vrednost AD konvertora
+ *
+ * Skok veci od INPUT_SNAP se ne filtrira. Polozaj se povecava samo ako
+ * i vrednost umanjena za INPUT_HYST daje veci polozaj, a smanjuje samo
+ * ako i vrednost uvecana za INPUT_HYST daje manji; skok za vise
+ * polozaja se prati odmah.
+ */
+static void Filter(uint8_t ch, unsigned int raw)
+{
+	InputChannel *c = &chan[ch];
+	uint8_t first = !(primed & (1 << ch));
+	uint16_t x = (uint16_t)raw << IIR_FRAC;
+	uint16_t d;
+	unsigned int hi, lo;
+	int v;
+
+	HAL_COST(SIM_COST_FILTER);
+	primed |= 1 << ch;
+	if(first)
+		c->iir = x;
+	else if(x > c->iir)
+	{
+		d = x - c->iir;
+		c->iir = d > SNAP ? x : c->iir + (d >> INPUT_IIR_SHIFT);
+	}
+	else
+	{
+		d = c->iir - x;
+		c->iir = d > SNAP ? x : c->iir - (d >> INPUT_IIR_SHIFT);
+	}
+
+	v = c->iir >> IIR_FRAC;
+	if(first)
+	{
+		c->pos = Map(c, v);
+		return;
+	}
+	hi = Map(c, v - INPUT_HYST);
+	lo = Map(c, v + INPUT_HYST);
+	if(hi > c->pos)
+		c->pos = hi;
+	else if(lo < c->pos)
+		c->pos = lo;
+}
+
+/**
+ * @brief Obrada dogadjaja iz reda
+ * @return Broj procitanih odbiraka potenciometara
+ *
+ * Svaki odbirak prolazi kroz filtar, pa propusteni frejmovi ne menjaju
+ * odziv filtra.
+ */
+uint8_t Input_Update(void)
+{
+	Event e;
+	uint8_t n = 0;
+
+	while(Event_Pop(&e))
+	{
+		switch(e.type)
+		{
+		case EVENT_PADDLE:
+			Filter(e.ch ? 1 : 0, e.value);
+			stamp = e.stamp;
+			n++;
+			break;
+		case EVENT_BUTTON:
+			button = 1;
+			break;
+		default:
+			break;
+		}
+	}
+	return n;
+}
+
+/**
+ * @brief Polozaj igraca posle poslednjeg Input_Update
+ * @param Redni broj igraca (0 ili 1)
+ * @return Polozaj u opsegu 0 - INPUT_POSITIONS-1
+ */
+unsigned int Input_Paddle(uint8_t ch)
+{
+	return chan[ch ? 1 : 0].pos;
+}
+
+/**
+ * @brief Da li je taster pritisnut
+ * @return 1 ako je od poslednjeg Input_Reset procitan pritisak tastera
+ */
+uint8_t Input_Button(void)
+{
+	return button;
+}
+
+/**
+ * @brief Vreme nastanka poslednjeg procitanog odbirka
+ * @return HAL_TIMESTAMP() iz prekidne rutine AD konvertora
+ */
+uint16_t Input_Stamp(void)
+{
+	return stamp;
+}
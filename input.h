@@ -0,0 +1,100 @@
+/**
+ * @file input.h
+ * @brief Obrada ulaza sa potenciometara igraca
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Prekidna rutina AD konvertora upisuje odbirke (vec usrednjene, videti
+ * HAL_ADC_OVERSAMPLE_SHIFT) u red dogadjaja (event.h), zajedno sa
+ * pritiscima tastera. Input_Update jednom po frejmu prazni red: svaki
+ * odbirak se propusta kroz IIR filtar prvog reda, pa se preslikava u
+ * polozaj igraca sa histerezisom: polozaj se menja tek kada filtrirana
+ * vrednost predje granicu susednog polozaja za INPUT_HYST. Tako sum
+ * potenciometra ne pomera igraca napred-nazad izmedju dva polozaja i
+ * ne izaziva ponovno iscrtavanje.
+ *
+ * Opseg vrednosti koji daje potenciometar (Input_Calibrate) se
+ * preslikava na svih INPUT_POSITIONS polozaja, od vrha do dna ekrana.
+ */
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <stdint.h>
+
+/**
+ * Broj polozaja igraca: visina ekrana (40 piksela) minus visina igraca
+ * (8 piksela), plus jedan
+ */
+#define INPUT_POSITIONS 33
+
+/**
+ * Koeficijent IIR filtra je 1 / 2^INPUT_IIR_SHIFT; 0 iskljucuje filtar.
+ * Svaki korak vise prepolovljava sum, ali produzava kasnjenje za oko
+ * jedan frejm
+ */
+#ifndef INPUT_IIR_SHIFT
+#define INPUT_IIR_SHIFT 1
+#endif
+
+/**
+ * Promena veca od INPUT_SNAP jedinica AD konvertora se preuzima bez
+ * filtriranja, pa brz pokret igraca nema kasnjenje filtra
+ */
+#ifndef INPUT_SNAP
+#define INPUT_SNAP 256
+#endif
+
+/**
+ * Sirina histerezisa u jedinicama AD konvertora
+ */
+#ifndef INPUT_HYST
+#define INPUT_HYST 16
+#endif
+
+/**
+ * @brief Zaboravljanje prethodnih vrednosti i dogadjaja iz reda
+ *
+ * Sledeci Input_Update preuzima vrednosti AD konvertora bez filtriranja.
+ */
+void Input_Reset(void);
+
+/**
+ * @brief Podesavanje opsega vrednosti potenciometra
+ * @param Redni broj igraca (0 ili 1)
+ * @param Vrednost AD konvertora za gornji polozaj
+ * @param Vrednost AD konvertora za donji polozaj (bar INPUT_POSITIONS
+ * iznad prethodne)
+ * @return 0 ako je opseg neispravan i prethodni je zadrzan
+ */
+uint8_t Input_Calibrate(uint8_t, unsigned int, unsigned int);
+
+/**
+ * @brief Obrada dogadjaja iz reda
+ * @return Broj procitanih odbiraka potenciometara
+ *
+ * Poziva se jednom po frejmu, pre Input_Paddle.
+ */
+uint8_t Input_Update(void);
+
+/**
+ * @brief Polozaj igraca posle poslednjeg Input_Update
+ * @param Redni broj igraca (0 ili 1)
+ * @return Polozaj u opsegu 0 - INPUT_POSITIONS-1
+ */
+unsigned int Input_Paddle(uint8_t);
+
+/**
+ * @brief Da li je taster pritisnut
+ * @return 1 ako je od poslednjeg Input_Reset procitan pritisak tastera
+ */
+uint8_t Input_Button(void);
+
+/**
+ * @brief Vreme nastanka poslednjeg procitanog odbirka
+ * @return HAL_TIMESTAMP() iz prekidne rutine AD konvertora
+ *
+ * Sluzi za merenje kasnjenja od odbirka do prikaza (PROFILE_INPUT).
+ */
+uint16_t Input_Stamp(void);
+
+#endif /* INPUT_H_ */
@@ -18,85 +18,164 @@
  *
  *  Igraci se upravljaju pomocu potenciometara povezanih na AD konvertore
  */
-#include <msp430.h> 
 #include <stdint.h>
 
-#include "init.h"
+#include "hal.h"
+#include "asset.h"
+#include "event.h"
 #include "game.h"
+#include "hud.h"
+#include "input.h"
 #include "oled.h"
+#include "prng.h"
+#include "profile.h"
+#include "sched.h"
+#include "trace.h"
 
 /**
- * Indikator koji postavlja tajmer u prekidu i signalizira programu
- * da treba da osvezi ekran.
+ * Rokovi zadataka, od prekida tajmera, u taktovima HAL_TIMESTAMP.
+ * Zadaci se izvrsavaju jedan za drugim, pa su rokovi rastuci; slanje
+ * mora biti pokrenuto pre sledeceg prekida.
  */
-volatile uint8_t TimerFlag = 0;
+#define INPUT_DEADLINE   (PROF_FRAME_BUDGET / 8)
+#define PHYSICS_DEADLINE (PROF_FRAME_BUDGET / 4)
+#define RENDER_DEADLINE  (PROF_FRAME_BUDGET / 2)
+#define FLUSH_DEADLINE   (PROF_FRAME_BUDGET - 1)
 
 /**
- * Indikator koji se postavlja pritiskom tastera S4 i po pritisku
- * igra pocinje.
+ * Redni brojevi zadataka igre (fizika, iscrtavanje, slanje); ukljucuju
+ * se pritiskom tastera
  */
-volatile uint8_t ResetGame = 0;	//Igra se resetuje na pocetku
+static uint8_t game_task[3];
 
 /**
- * Vrednosti potenciometara koji predstavljaju polozaj igraca.
- * Ucitavaju se u prekidnoj rutini AD konvertora
+ * Indikator da je igra pocela
  */
-volatile unsigned int adc1val = MAX_ADC_VAL/2, adc2val = MAX_ADC_VAL/2;
+static uint8_t started = 0;
 
-extern const uint8_t start_screen[];
+/**
+ * Broj odbiraka potenciometara procitanih od prethodnog slanja frejma
+ */
+static uint8_t samples = 0;
+
+#if LATE_LATCH
+/**
+ * Broj odbiraka procitanih pri kasnom ocitavanju igraca u tekucem frejmu
+ */
+static uint8_t latched = 0;
+
+/**
+ * @brief Kasno ocitavanje igraca (SetBoardLatch)
+ * @param Adresa na koju se upisuje polozaj prvog igraca
+ * @param Adresa na koju se upisuje polozaj drugog igraca
+ *
+ * Pokrece se nova sekvenca AD konverzija, pa su polozaji sveziji od
+ * odbirka koji je stigao pre prekida tajmera.
+ */
+static void LatchBoards(unsigned int *pos1, unsigned int *pos2)
+{
+	HAL_SamplePaddles();
+	latched += Input_Update();
+	*pos1 = Input_Paddle(0);
+	*pos2 = Input_Paddle(1);
+}
+#endif
+
+/**
+ * @brief Zadatak citanja ulaza
+ *
+ * Prazni red dogadjaja. Kada se procita pritisak tastera, ukljucuju se
+ * zadaci igre, pocevsi od sledeceg prekida tajmera.
+ */
+static void InputTask(void)
+{
+	uint8_t k;
+
+	samples += Input_Update();
+	if(!started && Input_Button())
+	{
+		started = 1;
+		samples = 0;
+		for(k = 0; k < 3; k++)
+			Sched_Enable(game_task[k], 1);
+	}
+}
+
+/**
+ * @brief Zadatak fizike
+ *
+ * Fizika napreduje za sve prekide od prethodnog izvrsavanja, pa
+ * propusteni periodi ne usporavaju igru.
+ */
+static void PhysicsTask(void)
+{
+	AdvanceClock(Sched_Elapsed());
+	UpdateGame(Input_Paddle(0), Input_Paddle(1));	//INPUT_POSITIONS polozaja plocice
+}
+
+/**
+ * @brief Zadatak slanja frejma
+ */
+static void FlushTask(void)
+{
+	FlushFrame();
+#if LATE_LATCH
+	samples += latched;
+	latched = 0;
+#endif
+	if(samples)
+		PROFILE_INPUT(Input_Stamp());
+	samples = 0;
+	HUD_TICK(Sched_Elapsed());
+}
 
 /*
  * @brief Glavna funkcija
  *
- * Funkcija inicijalizuje hardver pa potom u beskonacnoj petlji
- * proverava da li je tajmer postavio svoj indikator. Ako jeste
- * osvezava ekran pozivom funkcije RefreshScreen.
+ * Funkcija inicijalizuje hardver, dodaje zadatke rasporedjivacu i
+ * prepusta mu izvrsavanje. Svi zadaci imaju period od jednog prekida
+ * tajmera i izvrsavaju se redom: ulaz, fizika, iscrtavanje, slanje.
+ * Zadaci igre cekaju pritisak tastera S4.
  */
 int main(void) {
-    WDTCTL = WDTPW | WDTHOLD;	// Stop watchdog timer
-	
-    initADC();
-	initTMRA();
-	initMBUS1();
-	initBUTTON();
+    HAL_Init();
 	OLED_Initialize();
-    __bis_SR_register(GIE);		// globalna dozvola maskirajucih prekida
-    OLED_PutPicture(start_screen);
-
-    while(1)
-    {
-    	while(!ResetGame);
-//    	ResetGame = 0;
-    	if(TimerFlag){
-    		RefreshScreen(adc1val >> 7, adc2val >> 7, ResetGame);  //Maksimalno 32 polozaja plocice
-    		TimerFlag = 0;
-    	}
-    	ResetGame = 1;
-    }
+	Prng_Seed(HAL_Entropy());	// pre dozvole prekida, AD konvertor je slobodan
+    HAL_EnableInterrupts();		// globalna dozvola maskirajucih prekida
+    OLED_PutAsset(start_screen);
+#if LATE_LATCH
+    SetBoardLatch(LatchBoards);
+#endif
+
+    Sched_Add(InputTask, 1, INPUT_DEADLINE, 1);
+    game_task[0] = Sched_Add(PhysicsTask, 1, PHYSICS_DEADLINE, 0);
+    game_task[1] = Sched_Add(RenderFrame, 1, RENDER_DEADLINE, 0);
+    game_task[2] = Sched_Add(FlushTask, 1, FLUSH_DEADLINE, 0);
+
+    Sched_Run();
 }
 
 /**
- * @brief Prekidna rutina tastera S4
+ * @brief Obrada pritiska tastera S4
  *
- * U prekidnoj rutini se postavlja fleg koji oznacava da treba poceti
- * igru, pa se potom brise indikator prekida iz Interrupt Flag registra.
+ * Poziva se iz prekidne rutine tastera i upisuje pritisak u red
+ * dogadjaja; glavni program ga cita u Input_Update.
  */
-#pragma vector=PORT2_VECTOR
-__interrupt void port2handler(void)
+void HAL_ButtonHandler(void)
 {
-	ResetGame = 1;		// registruje se prekid tastera
-	P2IFG &= ~BIT7;				// brisanje flega
+	TRACE(TRACE_BUTTON_ISR, 0);
+	Event_Push(EVENT_BUTTON, 0, 0);		// registruje se prekid tastera
 }
 
 /**
- * @brief Prekidna rutina TajmerA0
+ * @brief Obrada prekida TajmerA0
  *
- * Zadatak prekidne rutine je samo da postavi indikator da je tajmer
- * izmerio odredjeno vreme i da je vreme da se prikaze novi frejm na
- * Oled W.
+ * Prekid se samo prijavljuje rasporedjivacu, koji u glavnoj petlji
+ * izvrsava zadatke kojima je istekao period i broji propustene
+ * prekide.
  */
-#pragma vector=TIMER0_A0_VECTOR
-__interrupt void Timer_A (void)
+void HAL_TimerHandler(void)
 {
-	TimerFlag = 1;
+	TRACE(TRACE_TIMER_TICK, 0);
+	Sched_Tick();
 }
@@ -4,38 +4,86 @@
  * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
  * @date 2016
  */
-#include <msp430.h>
+#include "hal.h"
+#include "asset.h"
+#include "blit.h"
 #include "oled.h"
+#include "oled_queue.h"
+#include "trace.h"
 
 /**
  * Postavljanje bita CS na MikroBus magistrali
  */
-#define SET_CS      	P3OUT |=  BIT0
+#define SET_CS      	HAL_CS_HIGH()
 
 /**
  * Brisanje bita CS na MikroBus magistrali
  */
-#define RESET_CS		P3OUT &= ~BIT0
+#define RESET_CS		HAL_CS_LOW()
 
 /**
  * Postavljanje bita DC na MikroBus magistrali
  */
-#define SET_DC			P4OUT |=  BIT1
+#define SET_DC			HAL_DC_HIGH()
 
 /**
  * Brisanje bita DC na MikroBus magistrali
  */
-#define RESET_DC		P4OUT &= ~BIT1
+#define RESET_DC		HAL_DC_LOW()
 
 /**
  * Postavljanje bita RST na MikroBus magistrali
  */
-#define SET_RST			P2OUT |=  BIT0
+#define SET_RST			HAL_RST_HIGH()
 
 /**
  * Brisanje bita RST na MikroBus magistrali
  */
-#define RESET_RST		P2OUT &= ~BIT0
+#define RESET_RST		HAL_RST_LOW()
+
+/**
+ * Pomeraj kolone: displej od 96 kolona je povezan na kolone 32 - 127
+ * kontrolera SSD1306.
+ */
+#define OLED_COLUMN_OFFSET		32
+
+/**
+ * Komande za postavljanje prozora: SSD1306_COLUMNADDR sa prvom i
+ * poslednjom kolonom i SSD1306_PAGEADDR sa prvom i poslednjom stranom
+ */
+typedef uint8_t WindowCmds[6];
+
+/**
+ * Cena ponovnog adresiranja prozora unutar iste strane, izrazena u broju
+ * bajtova na SPI magistrali: komande prozora i jos priblizno jedan bajt
+ * za promenu DC signala i cekanje da se isprazni pomeracki registar.
+ * Niz nepromenjenih bajtova kraci ili jednak ovoj vrednosti se salje
+ * ponovo umesto da se prozor ponovo adresira.
+ */
+#define OLED_COLUMN_ADDR_COST	((uint8_t)sizeof(WindowCmds) + 1)
+
+/**
+ * Kopija slike koja je poslednja poslata na displej.
+ * Sluzi za odredjivanje delova slike koji su se promenili.
+ */
+static BlitImage shadow;
+
+/**
+ * Strane za koje kopija u nizu shadow odgovara sadrzaju displeja
+ * (jedan bit po strani).
+ */
+static uint8_t shadow_valid = 0;
+
+/**
+ * Vrednost shadow_valid kada je poznat sadrzaj celog displeja
+ */
+#define SHADOW_ALL ((1 << OLED_BYTE_HEIGHT) - 1)
+
+/**
+ * Broj bajtova (komande i podaci) poslatih za poslednju sliku
+ */
+static unsigned int frame_bytes = 0;
+
 
 /**
  * @brief Funkcija koja prosledjuje bajt kontroleru SSD1306 preko SPI magistrale
@@ -47,9 +95,9 @@
  */
 int SPI_B0_Write(uint8_t data)
 {
-	while(UCB0STAT & UCBUSY);
-	UCB0TXBUF = data;
-	while(UCB0STAT & UCBUSY);
+	while(HAL_SPI_BUSY());
+	HAL_SPI_WRITE(data);
+	while(HAL_SPI_BUSY());
 	return 0;
 }
 
@@ -63,6 +111,7 @@ int SPI_B0_Write(uint8_t data)
  */
 void OLED_Command(uint8_t temp)
 {
+  OLEDQ_WaitIdle();
   RESET_CS;
   RESET_DC;
   SPI_B0_Write(temp);
@@ -79,12 +128,67 @@ void OLED_Command(uint8_t temp)
  */
 void OLED_Data(uint8_t temp)
 {
+  OLEDQ_WaitIdle();
   RESET_CS;
   SET_DC;
   SPI_B0_Write(temp);
   SET_CS;
 }
 
+/**
+ * @brief Slanje niza bajtova bez pauza preko SPI magistrale
+ * @param Niz bajtova koji se salje
+ * @param Broj bajtova
+ *
+ * Sledeci bajt se upisuje cim se predajni registar oslobodi (UCTXIFG),
+ * dok se prethodni bajt jos salje iz pomerackog registra. Tek na kraju
+ * se ceka da se magistrala smiri (UCBUSY), da bi se CS smeo podici.
+ */
+static void SPI_B0_WriteBurst(const uint8_t *buf, unsigned int len)
+{
+	TRACE(TRACE_SPI_START, 0);
+	while(len--)
+	{
+		while(!HAL_SPI_TX_READY());
+		HAL_SPI_WRITE(*buf++);
+	}
+	while(HAL_SPI_BUSY());
+	TRACE(TRACE_SPI_END, 0);
+}
+
+/**
+ * @brief Slanje niza komandi kontroleru za OLED
+ * @param Niz komandi zajedno sa njihovim argumentima
+ * @param Broj bajtova u nizu
+ *
+ * CS i DC signali se postavljaju samo jednom za ceo niz.
+ */
+void OLED_Commands(const uint8_t *cmds, uint8_t len)
+{
+	OLEDQ_WaitIdle();
+	RESET_CS;
+	RESET_DC;
+	SPI_B0_WriteBurst(cmds, len);
+	SET_CS;
+}
+
+/**
+ * @brief Slanje niza podataka kontroleru za OLED
+ * @param Niz podataka
+ * @param Broj bajtova u nizu
+ *
+ * CS i DC signali se postavljaju samo jednom za ceo niz, pa je
+ * slanje znatno brze nego uzastopnim pozivima OLED_Data.
+ */
+void OLED_DataBurst(const uint8_t *data, unsigned int len)
+{
+	OLEDQ_WaitIdle();
+	RESET_CS;
+	SET_DC;
+	SPI_B0_WriteBurst(data, len);
+	SET_CS;
+}
+
 /**
  * @brief Inicijalizacija OLED displeja
  *
@@ -96,9 +200,9 @@ void OLED_Data(uint8_t temp)
 void OLED_Initialize()
 {
 	RESET_RST;
-	__delay_cycles(1048576);
+	HAL_DELAY_CYCLES(1048576);
 	SET_RST;
-	__delay_cycles(1048576);
+	HAL_DELAY_CYCLES(1048576);
     OLED_Command(SSD1306_DISPLAYOFF);             //0xAE  Set OLED Display Off
     OLED_Command(SSD1306_SETDISPLAYCLOCKDIV);     //0xD5  Set Display Clock Divide Ratio/Oscillator Frequency
     OLED_Command(0x80);
@@ -121,73 +225,280 @@ void OLED_Initialize()
     OLED_Command(0x25);
     OLED_Command(SSD1306_SETVCOMDETECT);          //0xDB   Set VCOMH Deselect Level
     OLED_Command(0x20);
+    OLED_Command(SSD1306_MEMORYMODE);             //0x20   Set Memory Addressing Mode
+    OLED_Command(0x00);                           //0x00   Horizontal Addressing Mode
     OLED_Command(SSD1306_DISPLAYALLON_RESUME);    //0xA4   Set Entire Display On/Off
     OLED_Command(SSD1306_NORMALDISPLAY);          //0xA6   Set Normal/Inverse Display
     OLED_Command(SSD1306_DISPLAYON);              //0xAF   Set OLED Display On
+
+    OLED_Invalidate();	// sadrzaj GDDRAM-a posle reseta nije poznat
 }
 
 /**
- * @brief Postavljanje trenutne vrednosti reda
- * @param Trenutna vrednost reda
+ * @brief Popunjavanje komandi za postavljanje prozora
+ * @param Niz u koji se upisuju komande
+ * @param Prva kolona prozora
+ * @param Poslednja kolona prozora
+ * @param Prva strana prozora
+ * @param Poslednja strana prozora
  *
- * Postoji 5 redova od po 8 piksela u koriscenom OLED displeju.
- * Komanda koja se prosledjuje displeju potrebno je da se sastoji
- * od prva 4 bita  '1010' i potom 4 bita koji predstavljaju broj
- * reda.
+ * Kolone se zadaju u koordinatama displeja (0 - 95): displej od 96
+ * kolona je povezan na kolone 32 - 127 kontrolera.
  */
-void OLED_SetRow(uint8_t add)
+static void WindowCommands(WindowCmds cmds, uint8_t col0, uint8_t col1,
+		uint8_t page0, uint8_t page1)
 {
-    add = 0xB0 | add; // Moguce kolone B0, B1, B2, B3, B4
-    OLED_Command(add);
+	cmds[0] = SSD1306_COLUMNADDR;
+	cmds[1] = col0 + OLED_COLUMN_OFFSET;
+	cmds[2] = col1 + OLED_COLUMN_OFFSET;
+	cmds[3] = SSD1306_PAGEADDR;
+	cmds[4] = page0;
+	cmds[5] = page1;
 }
 
 /**
- * @brief Postavljanje trenutne vrednosti kolone
- * @param Trenutna vrednost kolone
+ * @brief Postavljanje prozora u koji se upisuju podaci
+ * @param Prva kolona prozora
+ * @param Poslednja kolona prozora
+ * @param Prva strana prozora
+ * @param Poslednja strana prozora
  *
- * Kontroler SSD1306 sluzi za konfigurisanje OLED displeja
- * dimenzija 128 x 64 pa je potrebno izvrsiti odredjene modifikacije
- * da bi se ispravno postavila trenunta kolona.
+ * U horizontalnom rezimu adresiranja kontroler posle svakog bajta
+ * prelazi na sledecu kolonu prozora, a posle poslednje kolone na
+ * pocetak sledece strane, pa se ceo prozor popunjava jednim nizom
+ * podataka. Kolone se zadaju u koordinatama displeja (0 - 95).
  */
-void OLED_SetColumn(uint8_t add)
+void OLED_SetWindow(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1)
 {
-    add += 32;	// 0 - 95 -> 32 - 127
-    OLED_Command((SSD1306_SETHIGHCOLUMN | (add >> 4))); 	// SET_HIGH_COLUMN
-    OLED_Command((0x0F & add));        						// SET LOW_COLUMN
+	WindowCmds cmds;
+
+	WindowCommands(cmds, col0, col1, page0, page1);
+	OLED_Commands(cmds, sizeof(cmds));
 }
 
 /**
  * @brief Prosledjivanje slike na OLED displej
  * @param Slika koju zelimo da iscrtamo na displeju
  *
- * Slika se iscrtava tako sto se sukcesivno postavljaju vrednosti reda
- * i kolone i slanje bajta kao podatak na OLED koji predstavlja 8 piksela.
+ * Prozor se postavlja na ceo displej (96 x 40), pa se svih 480
+ * bajtova salje jednim nizom, bez ponovnog adresiranja strana.
  */
 void OLED_PutPicture(const uint8_t *pic)
 {
-    unsigned char i,j;
-    for(i = 0; i < OLED_BYTE_HEIGHT; i++) // 5*8=40 redova
+	OLED_SetWindow(0, OLED_WIDTH - 1, 0, OLED_BYTE_HEIGHT - 1);
+	OLED_DataBurst(pic, IMAGE_SIZE);
+	frame_bytes = sizeof(WindowCmds) + IMAGE_SIZE;
+
+	Blit_Copy(shadow.b, pic, IMAGE_SIZE);
+	shadow_valid = SHADOW_ALL;
+}
+
+/**
+ * @brief Prosledjivanje kompresovane slike na OLED displej
+ * @param Kompresovana slika (asset.h)
+ *
+ * Slika se dekoduje direktno na SPI magistralu: bajtovi literala se
+ * salju iz flash memorije, a ponovljeni bajtovi se salju vise puta.
+ * Dok se bajt salje, upisuje se u kopiju shadow, pa posle slanja
+ * OLED_PutPictureDiff ponovo salje samo promene.
+ */
+void OLED_PutAsset(const uint8_t *asset)
+{
+	AssetReader r;
+	AssetRun run;
+	uint8_t *sh = shadow.b;
+	uint8_t k, b;
+
+	OLED_SetWindow(0, OLED_WIDTH - 1, 0, OLED_BYTE_HEIGHT - 1);
+	RESET_CS;
+	SET_DC;
+	TRACE(TRACE_SPI_START, 0);
+	Asset_Begin(&r, asset);
+	while(Asset_Next(&r, &run))
+	{
+		for(k = 0; k < run.len; k++)
+		{
+			b = run.data[run.fill ? 0 : k];
+			while(!HAL_SPI_TX_READY());
+			HAL_SPI_WRITE(b);
+			*sh++ = b;
+		}
+	}
+	while(HAL_SPI_BUSY());
+	TRACE(TRACE_SPI_END, 0);
+	SET_CS;
+	frame_bytes = sizeof(WindowCmds) + IMAGE_SIZE;
+	shadow_valid = SHADOW_ALL;
+}
+
+/**
+ * @brief Slanje promenjenih nizova jedne strane
+ * @param Strana
+ * @param Nova sadrzina strane (OLED_WIDTH bajtova)
+ * @param 1 - podaci se salju iz kopije shadow, 0 - iz nove sadrzine
+ *
+ * Strana se poredi sa kopijom poslednje poslate slike i salju se samo
+ * nizovi bajtova koji su se promenili. Dva promenjena niza se spajaju
+ * ako je razmak izmedju njih najvise OLED_COLUMN_ADDR_COST bajtova, jer
+ * je tada jeftinije poslati nepromenjene bajtove nego ponovo postaviti
+ * prozor. Za svaki niz se postavlja prozor koji pocinje na prvoj
+ * promenjenoj koloni.
+ */
+static void DiffPage(uint8_t i, const uint8_t *p, uint8_t from_shadow)
+{
+    unsigned char j, k, end;
+    WindowCmds cmds;
+    uint8_t *sh = shadow.b + i * OLED_WIDTH;
+
+    j = 0;
+    while(j < OLED_WIDTH)
     {
-        OLED_SetRow(i);
-        OLED_SetColumn(0);
+        // Nepromenjeni bajtovi se preskacu po 16 bita
+        k = Blit_Same(p + j, sh + j, OLED_WIDTH - j);
+        HAL_COST(SIM_COST_DIFF_WORD * ((k + 1) >> 1));
+        j += k;
+        if(j >= OLED_WIDTH)
+            break;
 
-        for(j = 0; j < OLED_WIDTH; j++)  // 96 kolona piksela
+        // Trazi se kraj niza, pri cemu se premoscuju kratki razmaci
+        end = j + 1;
+        for(k = end; k < OLED_WIDTH && k - end <= OLED_COLUMN_ADDR_COST; k++)
         {
-            OLED_Data(*pic++);
+            if(p[k] != sh[k])
+                end = k + 1;
         }
+
+        HAL_COST(SIM_COST_DIFF_RUN + SIM_COST_COPY_WORD * ((end - j + 1) >> 1));
+        WindowCommands(cmds, j, OLED_WIDTH - 1, i, i);
+        Blit_Copy(sh + j, p + j, end - j);
+        OLEDQ_PushCommands(cmds, sizeof(cmds));
+        OLEDQ_PushData((from_shadow ? sh : p) + j, end - j);
+        frame_bytes += sizeof(cmds) + end - j;
+        j = end;
+    }
+}
+
+/**
+ * @brief Prosledjivanje samo promenjenih delova slike na OLED displej
+ * @param Slika koju zelimo da iscrtamo na displeju
+ *
+ * Svaka strana slike se poredi sa kopijom poslednje poslate slike i
+ * salju se samo nizovi bajtova koji su se promenili (DiffPage).
+ *
+ * Nizovi se dodaju u red za asinhrono slanje, pa funkcija ne ceka da
+ * se slika posalje. Slika ne sme da se menja dok OLED_IsIdle ne vrati 1.
+ *
+ * Ako sadrzaj displeja nije poznat, cela slika se salje sinhrono.
+ */
+void OLED_PutPictureDiff(const uint8_t *pic)
+{
+    unsigned char i;
+
+    if(shadow_valid != SHADOW_ALL)
+    {
+        OLED_PutPicture(pic);
+        return;
+    }
+
+    frame_bytes = 0;
+
+    for(i = 0; i < OLED_BYTE_HEIGHT; i++)
+        DiffPage(i, pic + i * OLED_WIDTH, 0);
+}
+
+/**
+ * @brief Prosledjivanje promenjenih delova jedne strane na OLED displej
+ * @param Strana (0 - OLED_BYTE_HEIGHT-1)
+ * @param Sadrzina strane (OLED_WIDTH bajtova)
+ *
+ * Koristi se kada se slika iscrtava strana po stranu, bez bafera za
+ * ceo frejm. Podaci se salju iz kopije shadow, pa se sadrzina strane
+ * moze menjati odmah po povratku iz funkcije, a kopija te strane se ne
+ * sme menjati dok se ona salje: pre slanja strane sledeceg frejma treba
+ * sacekati OLED_WaitIdle. Strana 0 zapocinje novi frejm (OLED_FrameBytes).
+ *
+ * Ako sadrzaj strane na displeju nije poznat, salje se cela strana.
+ */
+void OLED_PutPageDiff(uint8_t page, const uint8_t *data)
+{
+    if(page == 0)
+        frame_bytes = 0;
+
+    if(!(shadow_valid & (1 << page)))
+    {
+        // Kopija se popunjava komplementom, pa se salje cela strana
+        Blit_Copy(shadow.b + page * OLED_WIDTH, data, OLED_WIDTH);
+        Blit_Xor(shadow.b + page * OLED_WIDTH, 0xFF, OLED_WIDTH);
+        shadow_valid |= 1 << page;
     }
+
+    DiffPage(page, data, 1);
+}
+
+/**
+ * @brief Kopija slike koja je poslednja poslata na displej
+ * @return Adresa kopije (IMAGE_SIZE bajtova)
+ */
+const uint8_t *OLED_LastPicture(void)
+{
+    return shadow.b;
+}
+
+/**
+ * @brief Provera da li je zavrseno asinhrono slanje
+ * @return 1 ako nista nije ostalo u redu za slanje
+ */
+uint8_t OLED_IsIdle(void)
+{
+	return OLEDQ_IsIdle();
+}
+
+/**
+ * @brief Cekanje da se zavrsi asinhrono slanje
+ */
+void OLED_WaitIdle(void)
+{
+	OLEDQ_WaitIdle();
+}
+
+/**
+ * @brief Broj bajtova poslatih za poslednju sliku
+ * @return Broj bajtova komandi i podataka koje je poslala poslednja
+ * 		   OLED_PutPicture ili OLED_PutPictureDiff, odnosno niz poziva
+ * 		   OLED_PutPageDiff od strane 0
+ */
+unsigned int OLED_FrameBytes(void)
+{
+	return frame_bytes;
+}
+
+/**
+ * @brief Proglasavanje sadrzaja displeja nepoznatim
+ *
+ * Posle poziva ove funkcije, sledeci poziv OLED_PutPictureDiff salje
+ * celu sliku. Koristi se posle inicijalizacije displeja ili ako je
+ * sadrzaj GDDRAM-a promenjen mimo funkcija za slanje slike.
+ */
+void OLED_Invalidate(void)
+{
+    shadow_valid = 0;
 }
 
 /**
  * @brief Brisanje ekrana
  *
  * Displej se brise tako sto se ustvari ispise matrica sa
- * svim vrednostima 0.
+ * svim vrednostima 0. Prazna slika je zapisana u formatu asset.h, pa
+ * za nju ne treba bafer na steku.
  */
 void OLED_Clear(void)
 {
-	uint8_t pic[IMAGE_SIZE] = {0};
-	OLED_PutPicture(pic);
+	static const uint8_t blank[] = {
+		ASSET_ZERO | ASSET_COUNT,							// 64 nule
+		ASSET_ZERO | (OLED_WIDTH - ASSET_MAX_RUN - 1),		// ostatak strane
+		ASSET_PAGE | (OLED_BYTE_HEIGHT - 2)					// ostale strane
+	};
+	OLED_PutAsset(blank);
 }
 
 /**
@@ -81,21 +81,32 @@ void OLED_Command(uint8_t);
 void OLED_Data(uint8_t);
 
 /**
- * @brief Inicijalizacija OLED displeja
+ * @brief Slanje niza komandi kontroleru za OLED
+ * @param Niz komandi zajedno sa njihovim argumentima
+ * @param Broj bajtova u nizu
  */
-void OLED_Initialize(void);
+void OLED_Commands(const uint8_t *, uint8_t);
+
+/**
+ * @brief Slanje niza podataka kontroleru za OLED
+ * @param Niz podataka
+ * @param Broj bajtova u nizu
+ */
+void OLED_DataBurst(const uint8_t *, unsigned int);
 
 /**
- * @brief Postavljanje trenutne vrednosti reda
- * @param Trenutna vrednost reda
+ * @brief Inicijalizacija OLED displeja
  */
-void OLED_SetRow(uint8_t);
+void OLED_Initialize(void);
 
 /**
- * @brief Postavljanje trenutne vrednosti kolone
- * @param Trenutna vrednost kolone
+ * @brief Postavljanje prozora u koji se upisuju podaci
+ * @param Prva kolona prozora
+ * @param Poslednja kolona prozora
+ * @param Prva strana prozora
+ * @param Poslednja strana prozora
  */
-void OLED_SetColumn(uint8_t);
+void OLED_SetWindow(uint8_t, uint8_t, uint8_t, uint8_t);
 
 /**
  * @brief Prosledjivanje slike na OLED displej
@@ -103,6 +114,52 @@ void OLED_SetColumn(uint8_t);
  */
 void OLED_PutPicture(const uint8_t *);
 
+/**
+ * @brief Prosledjivanje kompresovane slike na OLED displej
+ * @param Kompresovana slika (asset.h)
+ */
+void OLED_PutAsset(const uint8_t *);
+
+/**
+ * @brief Prosledjivanje samo promenjenih delova slike na OLED displej
+ * @param Slika koju zelimo da iscrtamo na displeju
+ */
+void OLED_PutPictureDiff(const uint8_t *);
+
+/**
+ * @brief Prosledjivanje promenjenih delova jedne strane na OLED displej
+ * @param Strana (0 - OLED_BYTE_HEIGHT-1)
+ * @param Sadrzina strane (OLED_WIDTH bajtova)
+ */
+void OLED_PutPageDiff(uint8_t, const uint8_t *);
+
+/**
+ * @brief Kopija slike koja je poslednja poslata na displej
+ */
+const uint8_t *OLED_LastPicture(void);
+
+/**
+ * @brief Provera da li je zavrseno asinhrono slanje
+ * @return 1 ako nista nije ostalo u redu za slanje
+ */
+uint8_t OLED_IsIdle(void);
+
+/**
+ * @brief Cekanje da se zavrsi asinhrono slanje
+ */
+void OLED_WaitIdle(void);
+
+/**
+ * @brief Broj bajtova poslatih za poslednju sliku
+ * @return Broj bajtova komandi i podataka
+ */
+unsigned int OLED_FrameBytes(void);
+
+/**
+ * @brief Proglasavanje sadrzaja displeja nepoznatim
+ */
+void OLED_Invalidate(void);
+
 /**
  * @brief Podesavanje kontrasta OLED displeja
  * @param Vrednost kontrasta
@@ -0,0 +1,147 @@
+/**
+ * @file oled_queue.c
+ * @brief Implementacija reda deskriptora za asinhrono slanje podataka na OLED
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Red ima jednog proizvodjaca (glavni program) i jednog potrosaca
+ * (prekidna rutina transporta), pa indeksi ne zahtevaju zakljucavanje:
+ * glavni program menja samo tail, a transport samo head.
+ */
+#include <string.h>
+
+#include "oled_queue.h"
+
+/**
+ * Kruzni bafer deskriptora
+ */
+static OLEDQ_Desc queue[OLEDQ_SIZE];
+
+/**
+ * Indeks deskriptora koji se salje i indeks prvog slobodnog mesta
+ */
+static volatile uint8_t head = 0, tail = 0;
+
+/**
+ * Funkcija koja se poziva kada se red isprazni
+ */
+static void (*done_callback)(void) = 0;
+
+/**
+ * @brief Zauzimanje sledeceg slobodnog deskriptora
+ *
+ * Ako je red pun, ceka se da transport oslobodi mesto.
+ */
+static OLEDQ_Desc *Reserve(void)
+{
+	while(((tail + 1) & (OLEDQ_SIZE - 1)) == head)
+		OLEDQ_TransportWait();
+	return &queue[tail];
+}
+
+/**
+ * @brief Objavljivanje popunjenog deskriptora i pokretanje transporta
+ */
+static void Commit(void)
+{
+	tail = (tail + 1) & (OLEDQ_SIZE - 1);
+	OLEDQ_TransportKick();
+}
+
+/**
+ * @brief Dodavanje niza podataka u red
+ * @param Niz podataka
+ * @param Broj bajtova
+ *
+ * Niz se ne kopira, pa ne sme da se menja dok OLEDQ_IsIdle ne vrati 1.
+ */
+void OLEDQ_PushData(const uint8_t *data, unsigned int len)
+{
+	OLEDQ_Desc *d;
+	if(len == 0)
+		return;
+	d = Reserve();
+	d->buf = data;
+	d->len = len;
+	d->dc = OLEDQ_DATA;
+	Commit();
+}
+
+/**
+ * @brief Dodavanje niza komandi u red
+ * @param Niz komandi
+ * @param Broj bajtova, najvise OLEDQ_CMD_MAX
+ *
+ * Komande se kopiraju u deskriptor, pa niz moze biti na steku.
+ */
+void OLEDQ_PushCommands(const uint8_t *cmds, uint8_t len)
+{
+	OLEDQ_Desc *d;
+	if(len == 0 || len > OLEDQ_CMD_MAX)
+		return;
+	d = Reserve();
+	memcpy(d->cmd, cmds, len);
+	d->buf = d->cmd;
+	d->len = len;
+	d->dc = OLEDQ_COMMAND;
+	Commit();
+}
+
+/**
+ * @brief Provera da li je red prazan i sve poslato
+ * @return 1 ako transport nema sta da salje
+ *
+ * Deskriptor ostaje u redu dok ga transport ne posalje do kraja.
+ */
+uint8_t OLEDQ_IsIdle(void)
+{
+	return head == tail;
+}
+
+/**
+ * @brief Cekanje da se ceo red posalje
+ */
+void OLEDQ_WaitIdle(void)
+{
+	while(head != tail)
+		OLEDQ_TransportWait();
+}
+
+/**
+ * @brief Postavljanje funkcije koja se poziva kada se red isprazni
+ * @param Funkcija, ili 0 ako nije potrebna
+ *
+ * Funkcija se poziva iz konteksta transporta (na mikrokontroleru iz
+ * prekidne rutine), pa mora biti kratka.
+ */
+void OLEDQ_SetCallback(void (*cb)(void))
+{
+	done_callback = cb;
+}
+
+/**
+ * @brief Deskriptor koji se trenutno salje
+ * @return Deskriptor na pocetku reda, ili 0 ako je red prazan
+ */
+const OLEDQ_Desc *OLEDQ_Current(void)
+{
+	return head == tail ? 0 : &queue[head];
+}
+
+/**
+ * @brief Uklanjanje poslatog deskriptora iz reda
+ * @return Sledeci deskriptor, ili 0 ako je red ispraznjen
+ *
+ * Poziva je transport kada je poslednji bajt deskriptora poslat.
+ */
+const OLEDQ_Desc *OLEDQ_Advance(void)
+{
+	head = (head + 1) & (OLEDQ_SIZE - 1);
+	if(head == tail)
+	{
+		if(done_callback)
+			done_callback();
+		return 0;
+	}
+	return &queue[head];
+}
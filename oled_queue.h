@@ -0,0 +1,98 @@
+/**
+ * @file oled_queue.h
+ * @brief Deklaracija reda deskriptora za asinhrono slanje podataka na OLED
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Red ne zavisi od hardvera. Transport (DMA na mikrokontroleru, odnosno
+ * zamenski transport na racunaru) uzima deskriptore redom i prijavljuje
+ * kada je neki od njih poslat.
+ */
+#ifndef OLED_QUEUE_H_
+#define OLED_QUEUE_H_
+
+#include <stdint.h>
+
+/**
+ * Broj deskriptora u redu, mora biti stepen broja 2
+ */
+#define OLEDQ_SIZE 32
+
+/**
+ * Najveci broj bajtova komandi koji se cuva u jednom deskriptoru
+ */
+#define OLEDQ_CMD_MAX 6
+
+/**
+ * Vrednosti DC signala za deskriptor
+ */
+#define OLEDQ_COMMAND 0
+#define OLEDQ_DATA    1
+
+/**
+ * Deskriptor jednog niza bajtova koji se salje bez prekida.
+ * Komande se kopiraju u sam deskriptor, dok se za podatke cuva samo
+ * pokazivac, pa niz podataka ne sme da se menja dok se ne posalje.
+ */
+typedef struct
+{
+	const uint8_t *buf;
+	unsigned int len;
+	uint8_t dc;
+	uint8_t cmd[OLEDQ_CMD_MAX];
+} OLEDQ_Desc;
+
+/**
+ * @brief Dodavanje niza podataka u red
+ * @param Niz podataka
+ * @param Broj bajtova
+ */
+void OLEDQ_PushData(const uint8_t *, unsigned int);
+
+/**
+ * @brief Dodavanje niza komandi u red
+ * @param Niz komandi
+ * @param Broj bajtova, najvise OLEDQ_CMD_MAX
+ */
+void OLEDQ_PushCommands(const uint8_t *, uint8_t);
+
+/**
+ * @brief Provera da li je red prazan i sve poslato
+ * @return 1 ako transport nema sta da salje
+ */
+uint8_t OLEDQ_IsIdle(void);
+
+/**
+ * @brief Cekanje da se ceo red posalje
+ */
+void OLEDQ_WaitIdle(void);
+
+/**
+ * @brief Postavljanje funkcije koja se poziva kada se red isprazni
+ * @param Funkcija, ili 0 ako nije potrebna
+ */
+void OLEDQ_SetCallback(void (*)(void));
+
+/**
+ * @brief Deskriptor koji se trenutno salje
+ * @return Deskriptor na pocetku reda, ili 0 ako je red prazan
+ */
+const OLEDQ_Desc *OLEDQ_Current(void);
+
+/**
+ * @brief Uklanjanje poslatog deskriptora iz reda
+ * @return Sledeci deskriptor, ili 0 ako je red ispraznjen
+ */
+const OLEDQ_Desc *OLEDQ_Advance(void);
+
+/**
+ * @brief Pokretanje transporta ako trenutno ne salje (implementira transport)
+ */
+void OLEDQ_TransportKick(void);
+
+/**
+ * @brief Poziva se dok se ceka na transport (implementira transport)
+ */
+void OLEDQ_TransportWait(void);
+
+#endif /* OLED_QUEUE_H_ */
@@ -0,0 +1,52 @@
+/**
+ * @file prng.c
+ * @brief Generator pseudoslucajnih brojeva
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ */
+#include "prng.h"
+
+/**
+ * Stanje generatora (nikad nije nula)
+ */
+static uint16_t state = PRNG_SEED;
+
+/**
+ * @brief Postavljanje stanja generatora
+ * @param Pocetna vrednost; nula se zamenjuje sa PRNG_SEED
+ *
+ * Iz nule xorshift ne izlazi, pa ona nije dozvoljeno stanje.
+ */
+void Prng_Seed(uint16_t seed)
+{
+	state = seed ? seed : PRNG_SEED;
+}
+
+/**
+ * @brief Sledeci pseudoslucajan broj
+ * @return Vrednost u opsegu 1 - 65535
+ */
+uint16_t Prng_Next(void)
+{
+	uint16_t x = state;
+
+	x ^= x << 7;
+	x ^= x >> 9;
+	x ^= x << 8;
+	state = x;
+	return x;
+}
+
+/**
+ * @brief Pseudoslucajan broj iz zadatog opsega
+ * @param Broj mogucih vrednosti n (1 - 65535)
+ * @return Vrednost u opsegu 0 - n-1
+ *
+ * Visih 16 bitova proizvoda x * n je floor(x * n / 65536). Razlika u
+ * verovatnoci vrednosti je najvise n / 65536, sto je za male opsege
+ * koje koristi igra zanemarljivo.
+ */
+uint16_t Prng_Range(uint16_t n)
+{
+	return (uint16_t)(((uint32_t)Prng_Next() * n) >> 16);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file prng.h
+ * @brief Generator pseudoslucajnih brojeva
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Koristi se 16-bitni xorshift generator (pomeraji 7, 9, 8) koji prolazi
+ * kroz svih 65535 vrednosti razlicitih od nule. Korak su tri pomeranja i
+ * tri ekskluzivne disjunkcije nad jednom recju, bez mnozenja i deljenja.
+ * Broj iz opsega 0 - n-1 se dobija mnozenjem sa n i uzimanjem visih 16
+ * bitova proizvoda, takodje bez deljenja.
+ *
+ * Pocetno stanje se zadaje pri pokretanju (Prng_Seed), na mikrokontroleru
+ * iz suma AD konvertora (HAL_Entropy), pa se igre razlikuju od
+ * ukljucenja do ukljucenja.
+ */
+#ifndef PRNG_H_
+#define PRNG_H_
+
+#include <stdint.h>
+
+/**
+ * Stanje generatora dok se ne pozove Prng_Seed
+ */
+#define PRNG_SEED 5323
+
+/**
+ * @brief Postavljanje stanja generatora
+ * @param Pocetna vrednost; nula se zamenjuje sa PRNG_SEED
+ */
+void Prng_Seed(uint16_t);
+
+/**
+ * @brief Sledeci pseudoslucajan broj
+ * @return Vrednost u opsegu 1 - 65535
+ */
+uint16_t Prng_Next(void);
+
+/**
+ * @brief Pseudoslucajan broj iz zadatog opsega
+ * @param Broj mogucih vrednosti n (1 - 65535)
+ * @return Vrednost u opsegu 0 - n-1
+ */
+uint16_t Prng_Range(uint16_t);
+
+#endif /* PRNG_H_ */
@@ -0,0 +1,184 @@
+/**
+ * @file profile.c
+ * @brief Merenje trajanja pojedinih faza funkcije RefreshScreen
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Tajmer je 16-bitni, pa se razlike racunaju po modulu 2^16; faza
+ * mora da traje krace od 65536 taktova, sto je oko dva perioda
+ * Timera A. Isto vazi i za kasnjenje od ulaza do prikaza.
+ */
+#include "oled_queue.h"
+#include "profile.h"
+
+#if PROFILE_ENABLE
+
+/**
+ * Statistika faza
+ */
+static ProfileStats stats[PROF_STAGES];
+
+/**
+ * Vremena faza u tekucem frejmu i maska faza koje su izvrsene
+ */
+static uint16_t cur[PROF_STAGES];
+static uint16_t touched;
+
+/**
+ * Trenutak pocetka frejma i trenutak poslednje oznake
+ */
+static uint16_t t_start, t_last;
+
+/**
+ * Statistika kasnjenja od ulaza do prikaza, vreme nastanka odbirka u
+ * frejmu koji se salje i indikator da se ceka kraj slanja
+ */
+static ProfileStats latency;
+static uint16_t input_stamp;
+static volatile uint8_t input_pending = 0;
+
+/**
+ * @brief Dodavanje jednog merenja u statistiku
+ * @param Statistika
+ * @param Izmereno vreme
+ */
+static void Accumulate(ProfileStats *st, uint16_t t)
+{
+	if(st->count == 0 || t < st->min)
+		st->min = t;
+	if(t > st->max)
+		st->max = t;
+	st->sum += t;
+	if(++st->count == 0xFFFF)
+	{
+		// Sprecava se prekoracenje: zadrzava se srednja vrednost
+		st->sum >>= 1;
+		st->count >>= 1;
+	}
+}
+
+/**
+ * @brief Pocetak merenja frejma
+ */
+void Profile_Start(void)
+{
+	uint8_t s;
+	for(s = 0; s < PROF_STAGES; s++)
+		cur[s] = 0;
+	touched = 0;
+	t_start = t_last = HAL_TIMESTAMP();
+}
+
+/**
+ * @brief Kraj faze
+ * @param Faza kojoj se dodaje vreme od prethodne oznake
+ *
+ * Ista faza moze biti oznacena vise puta u frejmu (npr. iscrtavanje
+ * igraca i loptice), pa se vremena sabiraju.
+ */
+void Profile_Mark(uint8_t stage)
+{
+	uint16_t now = HAL_TIMESTAMP();
+	cur[stage] += (uint16_t)(now - t_last);
+	touched |= 1 << stage;
+	t_last = now;
+}
+
+/**
+ * @brief Kraj frejma
+ *
+ * U statistiku se ukljucuju samo faze koje su izvrsene u ovom frejmu,
+ * pa npr. faza PROF_BACKGROUND pokazuje najgori slucaj nove loptice.
+ */
+void Profile_End(void)
+{
+	uint8_t s;
+	cur[PROF_FRAME] = (uint16_t)(HAL_TIMESTAMP() - t_start);
+	touched |= 1 << PROF_FRAME;
+
+	for(s = 0; s < PROF_STAGES; s++)
+		if(touched & (1 << s))
+			Accumulate(&stats[s], cur[s]);
+}
+
+/**
+ * @brief Kraj slanja: poziva ga red za slanje kada se isprazni
+ *
+ * Izvrsava se u kontekstu transporta (prekidna rutina DMA).
+ */
+static void InputSent(void)
+{
+	if(input_pending)
+	{
+		Accumulate(&latency, (uint16_t)(HAL_TIMESTAMP() - input_stamp));
+		input_pending = 0;
+	}
+}
+
+/**
+ * @brief Frejm sa novim odbirkom ulaza je predat za slanje
+ * @param Vreme nastanka odbirka (HAL_TIMESTAMP)
+ *
+ * Poziva se posle RefreshScreen. Ako je red za slanje vec prazan (frejm
+ * bez promena, ili je poslat dok se slagao), kasnjenje se meri odmah;
+ * inace ga meri InputSent kada se red isprazni.
+ */
+void Profile_Input(uint16_t stamp)
+{
+	hal_irq_t state;
+
+	HAL_IRQ_SAVE(state);
+	OLEDQ_SetCallback(InputSent);
+	input_stamp = stamp;
+	input_pending = 1;
+	if(OLEDQ_IsIdle())
+		InputSent();
+	HAL_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief Ocitavanje statistike kasnjenja od ulaza do prikaza
+ * @param Adresa na koju se upisuje statistika
+ */
+void Profile_GetLatency(ProfileStats *out)
+{
+	hal_irq_t state;
+	HAL_IRQ_SAVE(state);
+	*out = latency;
+	HAL_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief Ocitavanje statistike jedne faze
+ * @param Faza
+ * @param Adresa na koju se upisuje statistika
+ *
+ * Srednja vrednost je sum / count. Ocitavanje se vrsi sa zabranjenim
+ * prekidima, za slucaj da se poziva iz prekidne rutine.
+ */
+void Profile_Get(uint8_t stage, ProfileStats *out)
+{
+	hal_irq_t state;
+	HAL_IRQ_SAVE(state);
+	*out = stats[stage];
+	HAL_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief Brisanje statistike
+ */
+void Profile_Reset(void)
+{
+	uint8_t s;
+	for(s = 0; s < PROF_STAGES; s++)
+	{
+		stats[s].min = stats[s].max = 0;
+		stats[s].sum = 0;
+		stats[s].count = 0;
+	}
+	latency.min = latency.max = 0;
+	latency.sum = 0;
+	latency.count = 0;
+}
+
+#endif /* PROFILE_ENABLE */
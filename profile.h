@@ -0,0 +1,129 @@
+/**
+ * @file profile.h
+ * @brief Merenje trajanja pojedinih faza funkcije RefreshScreen
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Trajanje faza se meri slobodnim tajmerom (HAL_TIMESTAMP, na
+ * mikrokontroleru Timer A1 na SMCLK), a za svaku fazu se pamte
+ * minimum, maksimum i srednja vrednost po frejmu. Merenje se ukljucuje
+ * makroom PROFILE_ENABLE; kada je iskljuceno, makroi za merenje se
+ * prevode u nista i modul ne zauzima memoriju.
+ *
+ * Meri se i kasnjenje od ulaza do prikaza: od trenutka kada je prekidna
+ * rutina AD konvertora upisala odbirak (Input_Stamp) do trenutka kada je
+ * poslednji bajt frejma u kome je taj odbirak koriscen poslat na OLED.
+ */
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+
+#include "hal.h"
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 0
+#endif
+
+/**
+ * Faze funkcije RefreshScreen
+ */
+#define PROF_BACKGROUND 0	// ucitavanje cele pozadine (nova igra)
+#define PROF_ERASE      1	// brisanje sprajtova i promene staticnog sloja
+#define PROF_NEXTSTATE  2	// fizika
+#define PROF_DRAW       3	// iscrtavanje sprajtova
+#define PROF_SCORE      4	// ispisivanje rezultata i pokazatelja
+#define PROF_WAIT       5	// cekanje da se posalje prethodni frejm
+#define PROF_SEND       6	// OLED_PutPictureDiff
+#define PROF_FRAME      7	// ceo frejm
+#define PROF_STAGES     8
+
+/**
+ * Broj taktova SMCLK (1.048576 MHz) u jednom periodu Timera A
+ * (1024 takta ACLK od 32768 Hz)
+ */
+#define PROF_FRAME_BUDGET 32768UL
+
+/**
+ * Statistika jedne faze, u taktovima tajmera po frejmu
+ */
+typedef struct
+{
+	uint16_t min;
+	uint16_t max;
+	uint32_t sum;
+	uint16_t count;		// broj frejmova u kojima je faza izvrsena
+} ProfileStats;
+
+#if PROFILE_ENABLE
+
+/**
+ * Pocetak merenja frejma: pamti se trenutak pocetka
+ */
+#define PROFILE_START()			Profile_Start()
+
+/**
+ * Kraj faze: vreme od prethodne oznake se dodaje fazi
+ */
+#define PROFILE_MARK(stage)		Profile_Mark(stage)
+
+/**
+ * Kraj frejma: vremena faza se ukljucuju u statistiku
+ */
+#define PROFILE_END()			Profile_End()
+
+/**
+ * Frejm sa novim odbirkom ulaza je predat za slanje
+ */
+#define PROFILE_INPUT(stamp)	Profile_Input(stamp)
+
+/**
+ * @brief Pocetak merenja frejma
+ */
+void Profile_Start(void);
+
+/**
+ * @brief Kraj faze
+ * @param Faza kojoj se dodaje vreme od prethodne oznake
+ */
+void Profile_Mark(uint8_t);
+
+/**
+ * @brief Kraj frejma
+ */
+void Profile_End(void);
+
+/**
+ * @brief Frejm sa novim odbirkom ulaza je predat za slanje
+ * @param Vreme nastanka odbirka (HAL_TIMESTAMP)
+ */
+void Profile_Input(uint16_t);
+
+/**
+ * @brief Ocitavanje statistike kasnjenja od ulaza do prikaza
+ * @param Adresa na koju se upisuje statistika
+ */
+void Profile_GetLatency(ProfileStats *);
+
+/**
+ * @brief Ocitavanje statistike jedne faze
+ * @param Faza
+ * @param Adresa na koju se upisuje statistika
+ */
+void Profile_Get(uint8_t, ProfileStats *);
+
+/**
+ * @brief Brisanje statistike
+ */
+void Profile_Reset(void);
+
+#else
+
+#define PROFILE_START()			((void)0)
+#define PROFILE_MARK(stage)		((void)0)
+#define PROFILE_END()			((void)0)
+#define PROFILE_INPUT(stamp)	((void)0)
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,249 @@
+/**
+ * @file sched.c
+ * @brief Kooperativni rasporedjivac periodicnih zadataka
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Prekidna rutina tajmera samo uvecava brojac prekida i pamti trenutak
+ * prekida (Sched_Tick). Glavna petlja (Sched_Run) poredi brojac sa
+ * trenutkom poslednjeg aktiviranja svakog zadatka, pa se prekidi koji
+ * su stigli dok je trajao dug zadatak ne gube nego se broje kao
+ * propusteni periodi.
+ */
+#include "hal.h"
+#include "sched.h"
+
+/**
+ * Zadatak i njegova statistika
+ */
+typedef struct
+{
+	void (*run)(void);
+	uint8_t period;			// u prekidima tajmera
+	uint8_t enabled;
+	uint16_t deadline;		// u taktovima HAL_TIMESTAMP, od prekida
+	uint16_t last;			// prekid poslednjeg aktiviranja, poravnat na period
+	uint16_t elapsed;		// prekidi od prethodnog aktiviranja
+	SchedStats st;
+} SchedTask;
+
+static SchedTask task[SCHED_MAX_TASKS];
+
+/**
+ * Broj dodatih zadataka
+ */
+static uint8_t tasks = 0;
+
+/**
+ * Zadatak koji se trenutno izvrsava
+ */
+static SchedTask *current = 0;
+
+/**
+ * Brojac prekida tajmera i trenutak poslednjeg prekida (HAL_TIMESTAMP)
+ */
+static volatile uint16_t ticks = 0;
+static volatile uint16_t tick_stamp = 0;
+
+/**
+ * Vrednost brojaca prekida pri poslednjem pozivu Sched_Dispatch
+ */
+static uint16_t seen = 0;
+
+/**
+ * @brief Brisanje statistike jednog zadatka
+ */
+static void ClearStats(SchedStats *st)
+{
+	st->runs = 0;
+	st->missed = 0;
+	st->overruns = 0;
+	st->exec_min = 0xFFFF;
+	st->exec_max = 0;
+	st->exec_sum = 0;
+	st->start_min = 0xFFFF;
+	st->start_max = 0;
+}
+
+/**
+ * @brief Dodavanje periodicnog zadatka
+ * @param Funkcija zadatka
+ * @param Period u prekidima tajmera (1 - 255)
+ * @param Rok za zavrsetak, od prekida tajmera, u taktovima HAL_TIMESTAMP
+ * @param 1 - zadatak je odmah aktivan, 0 - ceka Sched_Enable
+ * @return Redni broj zadatka, ili SCHED_NONE
+ */
+uint8_t Sched_Add(void (*run)(void), uint8_t period, uint16_t deadline,
+		uint8_t enabled)
+{
+	SchedTask *t;
+
+	if(tasks >= SCHED_MAX_TASKS || !period)
+		return SCHED_NONE;
+
+	t = &task[tasks];
+	t->run = run;
+	t->period = period;
+	t->deadline = deadline;
+	ClearStats(&t->st);
+	Sched_Enable(tasks, enabled);
+	return tasks++;
+}
+
+/**
+ * @brief Ukljucivanje i iskljucivanje zadatka
+ * @param Redni broj zadatka
+ * @param 1 - zadatak se izvrsava od sledeceg prekida, 0 - ne izvrsava se
+ *
+ * Period se racuna od prekida u kome je zadatak ukljucen, pa vreme dok
+ * je bio iskljucen ne ulazi u propustene periode. Kada se poziva iz
+ * zadatka, to je prekid koji Sched_Dispatch upravo obradjuje.
+ */
+void Sched_Enable(uint8_t id, uint8_t on)
+{
+	uint16_t base = current ? seen : ticks;
+
+	if(id >= SCHED_MAX_TASKS)
+		return;
+	task[id].last = base + 1 - task[id].period;
+	task[id].enabled = on;
+}
+
+/**
+ * @brief Prekid tajmera (poziva se iz prekidne rutine)
+ */
+void Sched_Tick(void)
+{
+	tick_stamp = HAL_TIMESTAMP();
+	ticks++;
+}
+
+/**
+ * @brief Izvrsavanje zadataka kojima je istekao period
+ * @return Broj izvrsenih zadataka
+ *
+ * Zadaci se izvrsavaju redom kojim su dodati. Kasnjenje pocetka i rok
+ * se racunaju od poslednjeg prekida tajmera pre poziva.
+ */
+uint8_t Sched_Dispatch(void)
+{
+	SchedTask *t;
+	SchedStats *st;
+	hal_irq_t s;
+	uint16_t now, stamp, due, start, exec;
+	uint8_t k, n, done = 0;
+
+	HAL_IRQ_SAVE(s);
+	now = ticks;
+	stamp = tick_stamp;
+	HAL_IRQ_RESTORE(s);
+
+	if(now == seen)
+		return 0;
+	seen = now;
+
+	for(k = 0; k < tasks; k++)
+	{
+		t = &task[k];
+		due = now - t->last;
+		if(!t->enabled || due < t->period)
+			continue;
+
+		// Broj celih perioda od prethodnog aktiviranja, bez deljenja
+		n = 0;
+		t->elapsed = 0;
+		while(due >= t->period)
+		{
+			due -= t->period;
+			t->elapsed += t->period;
+			if(n < 0xFF)
+				n++;
+		}
+		t->last = now - due;
+
+		st = &t->st;
+		st->missed += n - 1;
+
+		start = HAL_TIMESTAMP();
+		current = t;
+		t->run();
+		current = 0;
+		exec = HAL_TIMESTAMP() - start;
+
+		start -= stamp;
+		st->runs++;
+		st->exec_sum += exec;
+		if(exec < st->exec_min)
+			st->exec_min = exec;
+		if(exec > st->exec_max)
+			st->exec_max = exec;
+		if(start < st->start_min)
+			st->start_min = start;
+		if(start > st->start_max)
+			st->start_max = start;
+		if((uint16_t)(start + exec) > t->deadline)
+			st->overruns++;
+		done++;
+	}
+	return done;
+}
+
+/**
+ * @brief Beskonacna petlja rasporedjivaca
+ *
+ * Provera da li je stigao novi prekid i ulazak u rezim male potrosnje
+ * se rade sa zabranjenim prekidima, pa prekid koji stigne izmedju njih
+ * ne ostaje neobradjen do sledeceg.
+ */
+void Sched_Run(void)
+{
+	hal_irq_t s;
+
+	for(;;)
+	{
+		if(Sched_Dispatch())
+			continue;
+
+		HAL_IRQ_SAVE(s);
+		if(ticks == seen)
+			HAL_SLEEP();		// prekidi se dozvoljavaju pri ulasku
+		else
+			HAL_IRQ_RESTORE(s);
+	}
+}
+
+/**
+ * @brief Broj prekida tajmera od prethodnog izvrsavanja zadatka koji
+ * se trenutno izvrsava
+ *
+ * Zbir po svim izvrsavanjima jednak je broju prekida od ukljucenja
+ * zadatka, pa se vreme simulacije moze pomerati ovom vrednoscu.
+ */
+unsigned int Sched_Elapsed(void)
+{
+	return current ? current->elapsed : 0;
+}
+
+/**
+ * @brief Ocitavanje statistike zadatka
+ * @param Redni broj zadatka
+ * @param Adresa na koju se upisuje statistika
+ */
+void Sched_Get(uint8_t id, SchedStats *st)
+{
+	if(id < tasks)
+		*st = task[id].st;
+	else
+		ClearStats(st);
+}
+
+/**
+ * @brief Brisanje statistike svih zadataka
+ */
+void Sched_Reset(void)
+{
+	uint8_t k;
+
+	for(k = 0; k < tasks; k++)
+		ClearStats(&task[k].st);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file sched.h
+ * @brief Kooperativni rasporedjivac periodicnih zadataka
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Vreme rasporedjivaca su prekidi Timera A (Sched_Tick). Svaki zadatak
+ * ima period u prekidima tajmera i rok u taktovima slobodnog brojaca
+ * (HAL_TIMESTAMP), racunat od prekida koji ga je aktivirao. Zadaci se
+ * izvrsavaju do kraja, redom kojim su dodati, pa zadaci sa istim
+ * periodom cine niz (npr. ulaz, fizika, iscrtavanje, slanje).
+ *
+ * Za svaki zadatak se pamti:
+ *  - broj izvrsavanja i broj propustenih perioda (kada izmedju dva
+ *    izvrsavanja prodje vise od jednog perioda, prekidi se ne gube, ali
+ *    se broje; Sched_Elapsed daje koliko ih je bilo)
+ *  - broj izvrsavanja zavrsenih posle roka
+ *  - najkrace, najduze i ukupno trajanje izvrsavanja
+ *  - najmanje i najvece kasnjenje pocetka od prekida (razlika je jitter)
+ *
+ * Na racunaru prekide tajmera daje HAL_LinuxTick, a glavni program posle
+ * svakog poziva Sched_Dispatch, pa je redosled izvrsavanja uvek isti.
+ */
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include <stdint.h>
+
+/**
+ * Najveci broj zadataka
+ */
+#define SCHED_MAX_TASKS 4
+
+/**
+ * Vrednost koju Sched_Add vraca kada nema mesta za zadatak
+ */
+#define SCHED_NONE 0xFF
+
+/**
+ * Statistika jednog zadatka; vremena su u taktovima HAL_TIMESTAMP
+ */
+typedef struct
+{
+	uint16_t runs;			// broj izvrsavanja
+	uint16_t missed;		// propusteni periodi
+	uint16_t overruns;		// izvrsavanja zavrsena posle roka
+	uint16_t exec_min;
+	uint16_t exec_max;
+	uint32_t exec_sum;		// srednje trajanje je exec_sum / runs
+	uint16_t start_min;		// kasnjenje pocetka od prekida tajmera
+	uint16_t start_max;
+} SchedStats;
+
+/**
+ * @brief Dodavanje periodicnog zadatka
+ * @param Funkcija zadatka
+ * @param Period u prekidima tajmera (1 - 255)
+ * @param Rok za zavrsetak, od prekida tajmera, u taktovima HAL_TIMESTAMP
+ * @param 1 - zadatak je odmah aktivan, 0 - ceka Sched_Enable
+ * @return Redni broj zadatka, ili SCHED_NONE
+ */
+uint8_t Sched_Add(void (*)(void), uint8_t, uint16_t, uint8_t);
+
+/**
+ * @brief Ukljucivanje i iskljucivanje zadatka
+ * @param Redni broj zadatka
+ * @param 1 - zadatak se izvrsava od sledeceg prekida, 0 - ne izvrsava se
+ */
+void Sched_Enable(uint8_t, uint8_t);
+
+/**
+ * @brief Prekid tajmera (poziva se iz prekidne rutine)
+ */
+void Sched_Tick(void);
+
+/**
+ * @brief Izvrsavanje zadataka kojima je istekao period
+ * @return Broj izvrsenih zadataka
+ */
+uint8_t Sched_Dispatch(void);
+
+/**
+ * @brief Beskonacna petlja rasporedjivaca
+ *
+ * Izmedju prekida tajmera procesor spava (HAL_SLEEP).
+ */
+void Sched_Run(void);
+
+/**
+ * @brief Broj prekida tajmera od prethodnog izvrsavanja zadatka koji
+ * se trenutno izvrsava
+ */
+unsigned int Sched_Elapsed(void);
+
+/**
+ * @brief Ocitavanje statistike zadatka
+ * @param Redni broj zadatka
+ * @param Adresa na koju se upisuje statistika
+ */
+void Sched_Get(uint8_t, SchedStats *);
+
+/**
+ * @brief Brisanje statistike svih zadataka
+ */
+void Sched_Reset(void);
+
+#endif /* SCHED_H_ */
@@ -0,0 +1,334 @@
+/**
+ * @file sprite.c
+ * @brief Slaganje slike od staticnog sloja i pokretnih sprajtova
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Frejm se slaze pozivom Sprite_Erase pa Sprite_Draw:
+ *  - sprajtovi se brisu obrnutim redom po z vrednosti, vracanjem
+ *    sacuvanih bajtova, pa je bafer ponovo jednak staticnom sloju
+ *  - kopiraju se delovi staticnog sloja koji su se promenili
+ *  - sprajtovi se iscrtavaju redom po z vrednosti, a pre toga se
+ *    pamte bajtovi koje prekrivaju
+ */
+#include "asset.h"
+#include "blit.h"
+#include "hal.h"
+#include "oled.h"
+#include "sprite.h"
+
+/**
+ * Staticni sloj: pozadina i elementi koji se retko menjaju. Poravnat je
+ * na rec kao i baferi frejma, pa se delovi kopiraju po 16 bita.
+ */
+static BlitImage layer;
+
+/**
+ * Sprajtovi, poredjani po z vrednosti
+ */
+static Sprite *sprites[SPRITE_MAX];
+static uint8_t count = 0;
+
+/**
+ * Delovi staticnog sloja koje jos treba kopirati u svaki od bafera
+ */
+static struct
+{
+	unsigned int start, end;
+} dirty[2][SPRITE_DIRTY_SPANS];
+static uint8_t dirty_cnt[2];
+
+/**
+ * Rastojanje do sledece strane u baferu. U poslednjoj strani je 0, jer
+ * je tada gornji bajt maske uvek 0 (sprajt ne izlazi iz ekrana), pa se
+ * upis u "sledecu" stranu ne odrazava na sliku i ne izlazi iz bafera.
+ */
+static const unsigned int next_page[OLED_BYTE_HEIGHT] =
+	{ OLED_WIDTH, OLED_WIDTH, OLED_WIDTH, OLED_WIDTH, 0 };
+
+typedef char next_page_matches_height[OLED_BYTE_HEIGHT == 5 ? 1 : -1];
+
+/**
+ * @brief Pocetno stanje: staticni sloj se puni slikom, nema sprajtova
+ * @param Kompresovana slika kojom se puni staticni sloj (asset.h)
+ *
+ * Slika se dekoduje direktno u staticni sloj, koji se ceo kopira u oba
+ * bafera pri sledecem slaganju.
+ */
+void Sprite_Init(const uint8_t *asset)
+{
+	Asset_Decode(asset, layer.b);
+	count = 0;
+	dirty_cnt[0] = dirty_cnt[1] = 0;
+	Sprite_StaticChanged(0, IMAGE_SIZE);
+}
+
+/**
+ * @brief Staticni sloj, u koji se sme upisivati
+ * @return Adresa staticnog sloja (IMAGE_SIZE bajtova)
+ *
+ * Posle upisa treba pozvati Sprite_StaticChanged.
+ */
+uint8_t *Sprite_StaticLayer(void)
+{
+	return layer.b;
+}
+
+/**
+ * @brief Prijava promene dela staticnog sloja
+ * @param Indeks prvog promenjenog bajta
+ * @param Broj promenjenih bajtova
+ *
+ * Deo se dodaje u listu oba bafera; ako je lista puna, prosiruje se
+ * poslednji deo u listi tako da obuhvati i novi.
+ */
+void Sprite_StaticChanged(unsigned int start, unsigned int len)
+{
+	unsigned int end = start + len;
+	uint8_t b, n;
+
+	for(b = 0; b < 2; b++)
+	{
+		n = dirty_cnt[b];
+		if(n < SPRITE_DIRTY_SPANS)
+		{
+			dirty[b][n].start = start;
+			dirty[b][n].end = end;
+			dirty_cnt[b] = n + 1;
+		}
+		else
+		{
+			n--;
+			if(start < dirty[b][n].start)
+				dirty[b][n].start = start;
+			if(end > dirty[b][n].end)
+				dirty[b][n].end = end;
+		}
+	}
+}
+
+/**
+ * @brief Dodavanje sprajta u sliku
+ * @param Sprajt (mora da postoji dok se slika iscrtava)
+ *
+ * Sprajt se umece tako da niz ostane poredjan po z vrednosti; sprajtovi
+ * sa istom z vrednoscu se iscrtavaju redom kojim su dodati. Sprajt se ne
+ * dodaje ako je lista puna ili je sprajt siri od SPRITE_MAX_WIDTH, jer
+ * sacuvani bajtovi ne bi stali u SpriteSave.
+ */
+void Sprite_Add(Sprite *s)
+{
+	uint8_t k;
+
+	if(count >= SPRITE_MAX || s->width > SPRITE_MAX_WIDTH)
+		return;
+
+	s->save[0].valid = s->save[1].valid = 0;
+	for(k = count; k > 0 && sprites[k - 1]->z > s->z; k--)
+		sprites[k] = sprites[k - 1];
+	sprites[k] = s;
+	count++;
+}
+
+/**
+ * @brief Vracanje bajtova koje je sprajt prekrio
+ * @param Bafer frejma
+ * @param Sacuvani bajtovi za taj bafer
+ * @param Sirina sprajta
+ */
+static void Restore(uint8_t *buf, SpriteSave *sv, uint8_t width)
+{
+	uint8_t *p = buf + sv->idx, *q = p + sv->next;
+	uint8_t k;
+
+	HAL_COST(SIM_COST_SPRITE + SIM_COST_SPRITE_COLUMN * width);
+	for(k = 0; k < width; k++)
+	{
+		p[k] = sv->under[k];
+		q[k] = sv->under[SPRITE_MAX_WIDTH + k];
+	}
+	sv->valid = 0;
+}
+
+/**
+ * @brief Iscrtavanje sprajta uz pamcenje prekrivenih bajtova
+ * @param Bafer frejma
+ * @param Sprajt
+ * @param Sacuvani bajtovi za taj bafer
+ *
+ * Strana i maska se odredjuju jednom za ceo sprajt, a svaka kolona se
+ * upisuje u dve strane bez grananja.
+ */
+static void Draw(uint8_t *buf, const Sprite *s, SpriteSave *sv)
+{
+	unsigned int page = s->top >> 3;
+	uint16_t m = s->img[s->top & 7];
+	uint16_t c = s->cover[s->top & 7];
+	uint8_t lo = (uint8_t)m, hi = (uint8_t)(m >> 8);
+	uint8_t clo = (uint8_t)c, chi = (uint8_t)(c >> 8);
+	uint8_t *p, *q;
+	uint8_t k;
+
+	HAL_COST(SIM_COST_SPRITE + 2 * SIM_COST_SPRITE_COLUMN * s->width);
+	sv->idx = page * OLED_WIDTH + s->col;
+	sv->next = next_page[page];
+	sv->valid = 1;
+	p = buf + sv->idx;
+	q = p + sv->next;
+
+	for(k = 0; k < s->width; k++)
+	{
+		sv->under[k] = p[k];
+		sv->under[SPRITE_MAX_WIDTH + k] = q[k];
+	}
+
+	switch(s->mode)
+	{
+	case SPRITE_XOR:
+		for(k = 0; k < s->width; k++)
+		{
+			p[k] ^= lo;
+			q[k] ^= hi;
+		}
+		break;
+	case SPRITE_OPAQUE:
+		for(k = 0; k < s->width; k++)
+		{
+			p[k] = (p[k] & ~clo) | (lo & clo);
+			q[k] = (q[k] & ~chi) | (hi & chi);
+		}
+		break;
+	default:
+		for(k = 0; k < s->width; k++)
+		{
+			p[k] |= lo;
+			q[k] |= hi;
+		}
+		break;
+	}
+}
+
+/**
+ * @brief Brisanje sprajtova i kopiranje promena staticnog sloja
+ * @param Bafer frejma
+ * @param Indeks bafera (0 ili 1)
+ *
+ * Sprajtovi se brisu od onog koji je iscrtan poslednji, pa je posle
+ * brisanja bafer jednak staticnom sloju kakav je bio pri iscrtavanju.
+ * Zatim se kopiraju delovi staticnog sloja koji su se u medjuvremenu
+ * promenili.
+ */
+void Sprite_Erase(uint8_t *buf, uint8_t b)
+{
+	uint8_t k;
+
+	for(k = count; k > 0; k--)
+	{
+		Sprite *s = sprites[k - 1];
+		if(s->save[b].valid)
+			Restore(buf, &s->save[b], s->width);
+	}
+
+	for(k = 0; k < dirty_cnt[b]; k++)
+	{
+		unsigned int len = dirty[b][k].end - dirty[b][k].start;
+
+		HAL_COST(SIM_COST_COPY_WORD * ((len + 1) >> 1));
+		Blit_Copy(buf + dirty[b][k].start, layer.b + dirty[b][k].start, len);
+	}
+	dirty_cnt[b] = 0;
+}
+
+/**
+ * @brief Iscrtavanje sprajtova
+ * @param Bafer frejma
+ * @param Indeks bafera (0 ili 1)
+ *
+ * Vidljivi sprajtovi se iscrtavaju redom po z vrednosti.
+ */
+void Sprite_Draw(uint8_t *buf, uint8_t b)
+{
+	Sprite_DrawRange(buf, b, 0, 0xFF);
+}
+
+/**
+ * @brief Iscrtavanje sprajtova ciji je z u zadatom opsegu
+ * @param Bafer frejma
+ * @param Indeks bafera (0 ili 1)
+ * @param Najmanji z
+ * @param Najveci z
+ *
+ * Frejm se moze iscrtati u vise poziva, ako opsezi idu redom od manjeg
+ * z ka vecem; tada su sacuvani bajtovi isti kao posle Sprite_Draw, pa
+ * Sprite_Erase radi bez promene.
+ */
+void Sprite_DrawRange(uint8_t *buf, uint8_t b, uint8_t zmin, uint8_t zmax)
+{
+	uint8_t k;
+
+	for(k = 0; k < count; k++)
+	{
+		Sprite *s = sprites[k];
+		if(s->visible && s->z >= zmin && s->z <= zmax)
+			Draw(buf, s, &s->save[b]);
+	}
+}
+
+/**
+ * @brief Iscrtavanje jedne strane bez bafera za ceo frejm
+ * @param Bafer za jednu stranu (OLED_WIDTH bajtova)
+ * @param Strana
+ *
+ * Strana staticnog sloja se kopira u bafer, a zatim se preko nje
+ * iscrtavaju delovi vidljivih sprajtova koji padaju u tu stranu, redom
+ * po z vrednosti. Rezultat je isti kao odgovarajuca strana bafera
+ * frejma posle Sprite_Erase i Sprite_Draw.
+ */
+void Sprite_RenderPage(uint8_t *buf, uint8_t page)
+{
+	uint8_t k, j;
+
+	HAL_COST(SIM_COST_COPY_WORD * (OLED_WIDTH / 2));
+	Blit_Copy(buf, layer.b + page * OLED_WIDTH, OLED_WIDTH);
+
+	for(k = 0; k < count; k++)
+	{
+		const Sprite *s = sprites[k];
+		unsigned int top = s->top >> 3;
+		uint8_t m, c;
+		uint8_t *p = buf + s->col;
+
+		if(!s->visible)
+			continue;
+
+		// Donji bajt maske pada u stranu gornje ivice, gornji u sledecu
+		if(top == page)
+		{
+			m = (uint8_t)s->img[s->top & 7];
+			c = (uint8_t)s->cover[s->top & 7];
+		}
+		else if(top + 1 == page)
+		{
+			m = (uint8_t)(s->img[s->top & 7] >> 8);
+			c = (uint8_t)(s->cover[s->top & 7] >> 8);
+		}
+		else
+			continue;
+
+		switch(s->mode)
+		{
+		case SPRITE_XOR:
+			for(j = 0; j < s->width; j++)
+				p[j] ^= m;
+			break;
+		case SPRITE_OPAQUE:
+			for(j = 0; j < s->width; j++)
+				p[j] = (p[j] & ~c) | (m & c);
+			break;
+		default:
+			for(j = 0; j < s->width; j++)
+				p[j] |= m;
+			break;
+		}
+	}
+}
@@ -0,0 +1,136 @@
+/**
+ * @file sprite.h
+ * @brief Slaganje slike od staticnog sloja i pokretnih sprajtova
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Slika se sastoji od staticnog sloja (pozadina terena, rezultat,
+ * pokazatelji) i sprajtova koji se iscrtavaju preko njega redom po
+ * z vrednosti. Pre iscrtavanja sprajt pamti bajtove koje prekriva
+ * (save-under), a pri brisanju se vracaju upravo ti bajtovi, pa cena
+ * frejma zavisi samo od broja pokretnih objekata.
+ *
+ * Svaki bafer frejma ima svoje sacuvane bajtove i svoju listu delova
+ * staticnog sloja koje treba ponovo kopirati, jer se baferi smenjuju.
+ */
+#ifndef SPRITE_H_
+#define SPRITE_H_
+
+#include <stdint.h>
+
+/**
+ * Najveci broj sprajtova i najveca sirina sprajta u kolonama
+ */
+#define SPRITE_MAX       8
+#define SPRITE_MAX_WIDTH 4
+
+/**
+ * Broj promenjenih delova staticnog sloja koji se pamte po baferu;
+ * ako ih ima vise, poslednji se prosiruje
+ */
+#define SPRITE_DIRTY_SPANS 6
+
+/**
+ * Nacini iscrtavanja sprajta
+ */
+#define SPRITE_OR     0		// biti slike se postavljaju na 1
+#define SPRITE_XOR    1		// biti slike se invertuju
+#define SPRITE_OPAQUE 2		// pravougaonik sprajta se zamenjuje slikom
+
+/**
+ * Maska sprajta pomerena za o bita. Donji bajt se upisuje u stranu u
+ * kojoj je gornja ivica sprajta, a gornji bajt u sledecu stranu.
+ */
+#define SHIFTED(m, o) ((uint16_t)((uint16_t)(m) << (o)))
+
+/**
+ * Tabela maski sprajta za svih 8 vertikalnih pomeraja unutar strane
+ */
+#define SHIFT_TABLE(m) { SHIFTED(m, 0), SHIFTED(m, 1), SHIFTED(m, 2), SHIFTED(m, 3), \
+						 SHIFTED(m, 4), SHIFTED(m, 5), SHIFTED(m, 6), SHIFTED(m, 7) }
+
+/**
+ * Bajtovi koje je sprajt prekrio u jednom baferu
+ */
+typedef struct
+{
+	uint8_t valid;
+	unsigned int idx;		// indeks prvog bajta u baferu
+	unsigned int next;		// rastojanje do sledece strane (0 u poslednjoj)
+	uint8_t under[2 * SPRITE_MAX_WIDTH];
+} SpriteSave;
+
+/**
+ * Sprajt: slika visine najvise 9 piksela, zadata tabelama pomerenih
+ * maski (SHIFT_TABLE)
+ */
+typedef struct
+{
+	const uint16_t *img;	// pomerene maske slike
+	const uint16_t *cover;	// pomerene maske pravougaonika (SPRITE_OPAQUE)
+	uint8_t width;
+	uint8_t mode;
+	uint8_t z;				// veci z se iscrtava preko manjeg
+	uint8_t visible;
+	int col;				// prva kolona
+	unsigned int top;		// gornja ivica u pikselima
+	SpriteSave save[2];
+} Sprite;
+
+/**
+ * @brief Pocetno stanje: staticni sloj se puni slikom, nema sprajtova
+ * @param Kompresovana slika kojom se puni staticni sloj (asset.h)
+ */
+void Sprite_Init(const uint8_t *);
+
+/**
+ * @brief Staticni sloj, u koji se sme upisivati
+ * @return Adresa staticnog sloja (IMAGE_SIZE bajtova)
+ */
+uint8_t *Sprite_StaticLayer(void);
+
+/**
+ * @brief Prijava promene dela staticnog sloja
+ * @param Indeks prvog promenjenog bajta
+ * @param Broj promenjenih bajtova
+ */
+void Sprite_StaticChanged(unsigned int, unsigned int);
+
+/**
+ * @brief Dodavanje sprajta u sliku
+ * @param Sprajt (mora da postoji dok se slika iscrtava, sirine najvise
+ * SPRITE_MAX_WIDTH)
+ */
+void Sprite_Add(Sprite *);
+
+/**
+ * @brief Brisanje sprajtova i kopiranje promena staticnog sloja
+ * @param Bafer frejma
+ * @param Indeks bafera (0 ili 1)
+ */
+void Sprite_Erase(uint8_t *, uint8_t);
+
+/**
+ * @brief Iscrtavanje sprajtova
+ * @param Bafer frejma
+ * @param Indeks bafera (0 ili 1)
+ */
+void Sprite_Draw(uint8_t *, uint8_t);
+
+/**
+ * @brief Iscrtavanje sprajtova ciji je z u zadatom opsegu
+ * @param Bafer frejma
+ * @param Indeks bafera (0 ili 1)
+ * @param Najmanji z
+ * @param Najveci z
+ */
+void Sprite_DrawRange(uint8_t *, uint8_t, uint8_t, uint8_t);
+
+/**
+ * @brief Iscrtavanje jedne strane bez bafera za ceo frejm
+ * @param Bafer za jednu stranu (OLED_WIDTH bajtova)
+ * @param Strana
+ */
+void Sprite_RenderPage(uint8_t *, uint8_t);
+
+#endif /* SPRITE_H_ */
@@ -0,0 +1,181 @@
+/**
+ * @file text.c
+ * @brief Ispisivanje brojeva u bafer slike
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Svaka cifra je upisana u celiju sirine TEXT_GLYPH_WIDTH kolona i
+ * visine 8 piksela, koja se cela zamenjuje (i prazna mesta se brisu),
+ * a kolona izmedju dve cifre se ne menja. Promenjeni deo se odredjuje
+ * poredjenjem bajtova, pa obuhvata samo kolone koje su stvarno
+ * promenjene.
+ */
+#include "arith.h"
+#include "hal.h"
+#include "oled.h"
+#include "text.h"
+
+/**
+ * Font: TEXT_GLYPH_WIDTH kolona po znaku, bit 0 je gornji red
+ */
+static const uint8_t font[TEXT_GLYPHS * TEXT_GLYPH_WIDTH] = {
+		0x7C, 0xA2, 0x92, 0x8A, 0x7C,	// 0
+		0x00, 0x84, 0xFE, 0x80, 0x00,	// 1
+		0x84, 0xC2, 0xA2, 0x92, 0x8C,	// 2
+		0x42, 0x82, 0x8A, 0x96, 0x62,	// 3
+		0x30, 0x28, 0x24, 0xFE, 0x20,	// 4
+		0x4E, 0x8A, 0x8A, 0x8A, 0x72,	// 5
+		0x78, 0x94, 0x92, 0x92, 0x60,	// 6
+		0x02, 0xE2, 0x12, 0x0A, 0x06,	// 7
+		0x6C, 0x92, 0x92, 0x92, 0x6C,	// 8
+		0x0C, 0x92, 0x92, 0x52, 0x3C,	// 9
+		0x00, 0x00, 0x00, 0x00, 0x00	// prazno
+};
+
+/**
+ * Kesevi pomerenih cifara: donji bajt ide u stranu gornje ivice polja,
+ * a gornji u sledecu stranu. Pomeraj 0 oznacava prazan kes.
+ */
+static uint16_t cache[TEXT_CACHES][TEXT_GLYPHS * TEXT_GLYPH_WIDTH];
+static uint8_t cache_shift[TEXT_CACHES];
+static uint8_t cache_next = 0;
+
+typedef char text_caches_positive[TEXT_CACHES > 0 ? 1 : -1];
+
+/**
+ * Granice promenjenog dela bafera tokom jednog ispisa
+ */
+static uint8_t col_min, col_max, page_min, page_max;
+
+/**
+ * @brief Kes cifara pomerenih za zadati broj piksela
+ * @param Pomeraj (1 - 7)
+ * @return Pomerene kolone svih znakova fonta
+ *
+ * Ako nijedan kes nema trazeni pomeraj, popunjava se najstariji.
+ */
+static const uint16_t *Shifted(uint8_t shift)
+{
+	uint8_t c;
+	unsigned int k;
+
+	for(c = 0; c < TEXT_CACHES; c++)
+	{
+		if(cache_shift[c] == shift)
+			return cache[c];
+	}
+
+	c = cache_next;
+	cache_next = (cache_next + 1) % TEXT_CACHES;
+	for(k = 0; k < TEXT_GLYPHS * TEXT_GLYPH_WIDTH; k++)
+		cache[c][k] = (uint16_t)font[k] << shift;
+	cache_shift[c] = shift;
+	return cache[c];
+}
+
+/**
+ * @brief Upis dela kolone u bafer
+ * @param Bafer slike
+ * @param Strana
+ * @param Kolona
+ * @param Bitovi koji se upisuju
+ * @param Maska bitova koje zauzima celija
+ */
+static void Put(uint8_t *buf, uint8_t page, uint8_t col, uint8_t bits, uint8_t mask)
+{
+	uint8_t *p = &buf[page * OLED_WIDTH + col];
+	uint8_t b = (*p & ~mask) | bits;
+
+	if(b == *p)
+		return;
+	*p = b;
+	if(col < col_min)
+		col_min = col;
+	if(col > col_max)
+		col_max = col;
+	if(page < page_min)
+		page_min = page;
+	if(page > page_max)
+		page_max = page;
+}
+
+/**
+ * @brief Ispisivanje broja u polje, ako se promenio
+ * @param Polje
+ * @param Vrednost (0 - 65535)
+ * @param Bafer slike (IMAGE_SIZE bajtova)
+ * @param Adresa na koju se upisuje promenjeni deo bafera
+ * @return 1 ako se bafer promenio
+ *
+ * Cifre se racunaju od najmanje znacajne, a zatim se celije popunjavaju
+ * s leva na desno. Ako je polje na pocetku strane, kolone fonta se
+ * upisuju direktno, a inace se uzimaju iz kesa pomerenih cifara.
+ */
+uint8_t Text_Number(TextField *f, unsigned int v, uint8_t *buf, TextSpan *span)
+{
+	uint8_t digit[TEXT_MAX_DIGITS];
+	uint8_t n, i, g, k, col;
+	uint8_t page = f->y >> 3, shift = f->y & 7;
+	const uint16_t *shifted = shift ? Shifted(shift) : 0;
+
+	span->pages = 0;
+	if(f->valid && f->shown == v)
+		return 0;
+	f->valid = 1;
+	f->shown = v;
+
+	n = 0;
+	do
+	{
+		digit[n++] = ARITH_MOD(v, 10);
+		v = ARITH_DIV(v, 10);
+	} while(v && n < f->digits);
+	if(v)
+	{
+		for(n = 0; n < f->digits; n++)
+			digit[n] = 9;
+	}
+
+	col_min = page_min = 0xFF;
+	col_max = page_max = 0;
+	col = f->col;
+	for(i = 0; i < f->digits; i++, col += TEXT_ADVANCE)
+	{
+		if(f->align == TEXT_RIGHT)
+			g = f->digits - 1 - i < n ? digit[f->digits - 1 - i] : TEXT_BLANK;
+		else
+			g = i < n ? digit[n - 1 - i] : TEXT_BLANK;
+
+		HAL_COST(SIM_COST_GLYPH);
+		for(k = 0; k < TEXT_GLYPH_WIDTH; k++)
+		{
+			if(!shifted)
+				Put(buf, page, col + k, font[g * TEXT_GLYPH_WIDTH + k], 0xFF);
+			else
+			{
+				uint16_t c = shifted[g * TEXT_GLYPH_WIDTH + k];
+				Put(buf, page, col + k, (uint8_t)c, (uint8_t)(0xFF << shift));
+				Put(buf, page + 1, col + k, c >> 8, 0xFF >> (8 - shift));
+			}
+		}
+	}
+
+	if(col_min > col_max)
+		return 0;
+	span->page = page_min;
+	span->pages = page_max - page_min + 1;
+	span->col = col_min;
+	span->len = col_max - col_min + 1;
+	return 1;
+}
+
+/**
+ * @brief Zahtev da se polje iscrta pri sledecem ispisu
+ * @param Polje
+ *
+ * Koristi se kada se bafer u kome je polje ponovo ucita.
+ */
+void Text_Invalidate(TextField *f)
+{
+	f->valid = 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file text.h
+ * @brief Ispisivanje brojeva u bafer slike
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Broj se ispisuje u polje (TextField) sa zadatim polozajem, brojem
+ * cifara i poravnanjem. Polje se ponovo iscrtava samo kada se vrednost
+ * promeni, a funkcija vraca tacan deo bafera koji se promenio, pa se
+ * isti kod koristi za rezultat, pokazatelje (hud.h) i menije.
+ *
+ * Gornja ivica polja moze biti na bilo kom pikselu. Ako nije na pocetku
+ * strane, cifre se uzimaju iz kesa pomerenih slika, koji se popunjava
+ * pri prvom ispisu sa tim pomerajem.
+ */
+#ifndef TEXT_H_
+#define TEXT_H_
+
+#include <stdint.h>
+
+/**
+ * Broj kesa pomerenih cifara (po jedan za svaki pomeraj koji se
+ * koristi istovremeno); svaki zauzima TEXT_GLYPHS * TEXT_GLYPH_WIDTH
+ * 16-bitnih reci
+ */
+#ifndef TEXT_CACHES
+#define TEXT_CACHES 1
+#endif
+
+/**
+ * Sirina cifre u kolonama i razmak izmedju pocetaka dve cifre
+ */
+#define TEXT_GLYPH_WIDTH 5
+#define TEXT_ADVANCE     6
+
+/**
+ * Broj znakova u fontu: cifre 0 - 9 i prazno polje
+ */
+#define TEXT_BLANK   10
+#define TEXT_GLYPHS  11
+
+/**
+ * Najveci broj cifara u polju
+ */
+#define TEXT_MAX_DIGITS 5
+
+/**
+ * Poravnanje broja u polju
+ */
+#define TEXT_LEFT  0
+#define TEXT_RIGHT 1
+
+/**
+ * Polje u koje se ispisuje broj. Vrednosti vece od najvece koja staje
+ * u polje se prikazuju kao 9...9, a prazna mesta se brisu.
+ */
+typedef struct
+{
+	uint8_t col;			// prva kolona
+	uint8_t y;				// gornja ivica u pikselima (najvise 32)
+	uint8_t digits;			// broj cifara (1 - TEXT_MAX_DIGITS)
+	uint8_t align;
+	uint8_t valid;			// 0 - polje se iscrtava pri sledecem ispisu
+	unsigned int shown;		// prikazana vrednost
+} TextField;
+
+/**
+ * Inicijalizator polja
+ */
+#define TEXT_FIELD(col, y, digits, align) { (col), (y), (digits), (align), 0, 0 }
+
+/**
+ * Promenjeni deo bafera: kolone col - col+len-1 u stranama
+ * page - page+pages-1
+ */
+typedef struct
+{
+	uint8_t page;
+	uint8_t pages;			// 0 - nista se nije promenilo
+	uint8_t col;
+	uint8_t len;
+} TextSpan;
+
+/**
+ * @brief Ispisivanje broja u polje, ako se promenio
+ * @param Polje
+ * @param Vrednost (0 - 65535)
+ * @param Bafer slike (IMAGE_SIZE bajtova)
+ * @param Adresa na koju se upisuje promenjeni deo bafera
+ * @return 1 ako se bafer promenio
+ */
+uint8_t Text_Number(TextField *, unsigned int, uint8_t *, TextSpan *);
+
+/**
+ * @brief Zahtev da se polje iscrta pri sledecem ispisu
+ * @param Polje
+ */
+void Text_Invalidate(TextField *);
+
+#endif /* TEXT_H_ */
@@ -0,0 +1,231 @@
+/**
+ * @file pbm2asset.c
+ * @brief Pretvaranje PBM slika u kompresovani format (asset.h)
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Ulaz su slike 96 x 40 u PBM formatu (P1 ili P4), u kojima 1 znaci
+ * upaljen piksel. Izlaz je C fajl sa po jednim nizom za svaku sliku,
+ * koji se prevodi zajedno sa igricom (asset_data.c).
+ *
+ * Upotreba: pbm2asset ime slika.pbm [ime slika.pbm ...] > asset_data.c
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asset.h"
+#include "oled.h"
+
+/**
+ * Visina slike u pikselima
+ */
+#define HEIGHT (8 * OLED_BYTE_HEIGHT)
+
+/**
+ * @brief Preskakanje razmaka i komentara u zaglavlju PBM fajla
+ */
+static void SkipSpace(FILE *f)
+{
+	int c;
+	while((c = fgetc(f)) != EOF)
+	{
+		if(c == '#')
+		{
+			while((c = fgetc(f)) != EOF && c != '\n');
+		}
+		else if(c != ' ' && c != '\t' && c != '\r' && c != '\n')
+		{
+			ungetc(c, f);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Citanje PBM slike
+ * @param Ime fajla
+ * @param Slika u redosledu GDDRAM-a (IMAGE_SIZE bajtova)
+ * @return 0 ako je slika ucitana
+ */
+static int ReadPBM(const char *name, uint8_t *img)
+{
+	FILE *f = fopen(name, "rb");
+	char magic[3] = {0};
+	int w, h, x, y, c = 0, bit = 0;
+
+	if(!f)
+	{
+		perror(name);
+		return -1;
+	}
+	if(fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || (magic[1] != '1' && magic[1] != '4'))
+	{
+		fprintf(stderr, "%s: nije PBM slika\n", name);
+		fclose(f);
+		return -1;
+	}
+	SkipSpace(f);
+	if(fscanf(f, "%d", &w) != 1)
+		w = 0;
+	SkipSpace(f);
+	if(fscanf(f, "%d", &h) != 1)
+		h = 0;
+	if(w != OLED_WIDTH || h != HEIGHT)
+	{
+		fprintf(stderr, "%s: slika mora biti %d x %d\n", name, OLED_WIDTH, HEIGHT);
+		fclose(f);
+		return -1;
+	}
+	if(magic[1] == '4')
+		fgetc(f);	// jedan razmak posle zaglavlja
+
+	memset(img, 0, IMAGE_SIZE);
+	for(y = 0; y < HEIGHT; y++)
+	{
+		for(x = 0; x < OLED_WIDTH; x++)
+		{
+			if(magic[1] == '1')
+			{
+				SkipSpace(f);
+				c = fgetc(f);
+				bit = c == '1';
+				if(c != '0' && c != '1')
+					break;
+			}
+			else
+			{
+				if(x % 8 == 0 && (c = fgetc(f)) == EOF)
+					break;
+				bit = (c >> (7 - x % 8)) & 1;
+			}
+			if(bit)
+				img[(y / 8) * OLED_WIDTH + x] |= 1 << (y % 8);
+		}
+		if(x < OLED_WIDTH)
+		{
+			fprintf(stderr, "%s: slika je prekratka\n", name);
+			fclose(f);
+			return -1;
+		}
+	}
+	fclose(f);
+	return 0;
+}
+
+/**
+ * Izlazni bafer tokena; u najgorem slucaju svaki niz od ASSET_MAX_RUN
+ * bajtova dobija jedan token.
+ */
+static uint8_t out[IMAGE_SIZE + IMAGE_SIZE / ASSET_MAX_RUN + OLED_BYTE_HEIGHT + 1];
+static unsigned int out_len;
+
+/**
+ * @brief Zapisivanje niza bajtova koje ne vredi kompresovati
+ */
+static void Literal(const uint8_t *p, unsigned int len)
+{
+	unsigned int n;
+	while(len)
+	{
+		n = len > ASSET_MAX_RUN ? ASSET_MAX_RUN : len;
+		out[out_len++] = ASSET_LITERAL | (n - 1);
+		memcpy(out + out_len, p, n);
+		out_len += n;
+		p += n;
+		len -= n;
+	}
+}
+
+/**
+ * @brief Kompresovanje jedne strane
+ *
+ * Niz nula od bar 2 bajta i niz istih bajtova od bar 3 bajta se
+ * zapisuju jednim tokenom, a ostali bajtovi se skupljaju u literal.
+ */
+static void EncodePage(const uint8_t *p)
+{
+	unsigned int j = 0, lit = 0, r;
+
+	while(j < OLED_WIDTH)
+	{
+		for(r = 1; j + r < OLED_WIDTH && r < ASSET_MAX_RUN && p[j + r] == p[j]; r++);
+
+		if((p[j] == 0 && r >= 2) || r >= 3)
+		{
+			Literal(p + lit, j - lit);
+			out[out_len++] = (p[j] ? ASSET_FILL : ASSET_ZERO) | (r - 1);
+			if(p[j])
+				out[out_len++] = p[j];
+			j += r;
+			lit = j;
+		}
+		else
+			j++;
+	}
+	Literal(p + lit, j - lit);
+}
+
+/**
+ * @brief Kompresovanje slike
+ *
+ * Strana jednaka prethodnoj se zapisuje tokenom ponavljanja strane,
+ * a uzastopna ponavljanja se spajaju u jedan token.
+ */
+static void Encode(const uint8_t *img)
+{
+	unsigned int i, same = 0;
+
+	out_len = 0;
+	for(i = 0; i < OLED_BYTE_HEIGHT; i++)
+	{
+		if(i > 0 && !memcmp(img + i * OLED_WIDTH, img + (i - 1) * OLED_WIDTH, OLED_WIDTH))
+		{
+			same++;
+			continue;
+		}
+		if(same)
+			out[out_len++] = ASSET_PAGE | (same - 1);
+		same = 0;
+		EncodePage(img + i * OLED_WIDTH);
+	}
+	if(same)
+		out[out_len++] = ASSET_PAGE | (same - 1);
+}
+
+int main(int argc, char **argv)
+{
+	uint8_t img[IMAGE_SIZE];
+	unsigned int k;
+	int a;
+
+	if(argc < 3 || argc % 2 == 0)
+	{
+		fprintf(stderr, "Upotreba: %s ime slika.pbm [ime slika.pbm ...]\n", argv[0]);
+		return 1;
+	}
+
+	printf("/**\n"
+		   " * @file asset_data.c\n"
+		   " * @brief Kompresovane slike (napravio pbm2asset, ne menjati rucno)\n"
+		   " */\n"
+		   "#include <stdint.h>\n\n"
+		   "#include \"asset.h\"\n");
+
+	for(a = 1; a < argc; a += 2)
+	{
+		if(ReadPBM(argv[a + 1], img))
+			return 1;
+		Encode(img);
+
+		printf("\n/**\n * %s: %u bajtova (nekompresovano %d)\n */\n", argv[a + 1], out_len, IMAGE_SIZE);
+		printf("const uint8_t %s[] = {", argv[a]);
+		for(k = 0; k < out_len; k++)
+			printf("%s0x%02X%s", k % 16 ? " " : "\n\t\t", out[k], k + 1 < out_len ? "," : "");
+		printf("\n};\n");
+	}
+	return 0;
+}
+
+#endif /* __MSP430__ */
@@ -0,0 +1,125 @@
+/**
+ * @file trace2json.c
+ * @brief Pretvaranje zapisa dogadjaja u Chrome/Perfetto trace JSON
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Ulaz je sadrzaj strukture trace (trace.h) sacuvan iz debagera ili
+ * iz programa pong_host. Vremena su 16-bitna, pa se razmotavaju uz
+ * pretpostavku da je razmak izmedju dva uzastopna dogadjaja manji od
+ * 65536 taktova (prekid tajmera se javlja na svakih 32768 taktova).
+ * Izlaz se otvara u chrome://tracing ili ui.perfetto.dev.
+ *
+ * Upotreba: trace2json zapis.bin [ucestanost_tajmera_Hz] > trace.json
+ */
+#ifndef __MSP430__	// samo za racunar; CCS prevodi sve .c fajlove projekta
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "trace.h"
+
+/**
+ * Podrazumevana ucestanost tajmera (SMCLK)
+ */
+#define DEF_CLOCK 1048576.0
+
+/**
+ * Niti u prikazu
+ */
+#define TID_MAIN 1
+#define TID_SPI  2
+#define TID_ISR  3
+
+/**
+ * @brief Citanje 16-bitne vrednosti (little-endian)
+ */
+static unsigned int Read16(const unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+/**
+ * @brief Ispis jednog dogadjaja
+ * @param Prvi dogadjaj u izlazu (bez zareza ispred)
+ * @param Ime
+ * @param Faza (B - pocetak, E - kraj, i - trenutni)
+ * @param Nit
+ * @param Vreme u mikrosekundama
+ * @param Argument
+ */
+static void Emit(int first, const char *name, char ph, int tid, double us, int arg)
+{
+	printf("%s\n  {\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+			first ? "" : ",", name, ph, tid, us);
+	if(ph == 'i')
+		printf(",\"s\":\"t\"");
+	if(arg >= 0)
+		printf(",\"args\":{\"arg\":%d}", arg);
+	printf("}");
+}
+
+int main(int argc, char **argv)
+{
+	unsigned char raw[6 + 4 * TRACE_SIZE];
+	double clock = argc > 2 ? atof(argv[2]) : DEF_CLOCK;
+	unsigned int head, count, i;
+	unsigned long long t = 0;
+	unsigned int prev = 0;
+	int first = 1;
+	FILE *f;
+
+	if(argc < 2 || clock <= 0)
+	{
+		fprintf(stderr, "upotreba: %s zapis.bin [ucestanost_Hz]\n", argv[0]);
+		return 2;
+	}
+	f = fopen(argv[1], "rb");
+	if(!f || fread(raw, 1, sizeof(raw), f) != sizeof(raw))
+	{
+		fprintf(stderr, "%s: zapis nije moguce procitati\n", argv[1]);
+		return 1;
+	}
+	fclose(f);
+
+	if(Read16(raw) != TRACE_MAGIC)
+	{
+		fprintf(stderr, "%s: pogresna oznaka zapisa\n", argv[1]);
+		return 1;
+	}
+	head = Read16(raw + 2) & (TRACE_SIZE - 1);
+	count = Read16(raw + 4);
+	if(count > TRACE_SIZE)
+		count = TRACE_SIZE;
+
+	printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	for(i = 0; i < count; i++)
+	{
+		const unsigned char *e = raw + 6 + 4 * ((head - count + i) & (TRACE_SIZE - 1));
+		unsigned int ts = Read16(e);
+		double us;
+
+		if(i > 0)
+			t += (ts - prev) & 0xFFFF;
+		prev = ts;
+		us = t * 1e6 / clock;
+
+		switch(e[2])
+		{
+		case TRACE_TIMER_TICK:	Emit(first, "timer", 'i', TID_ISR, us, -1); break;
+		case TRACE_ADC_ISR:		Emit(first, "adc", 'i', TID_ISR, us, e[3]); break;
+		case TRACE_BUTTON_ISR:	Emit(first, "button", 'i', TID_ISR, us, -1); break;
+		case TRACE_FRAME_START:	Emit(first, "frame", 'B', TID_MAIN, us, -1); break;
+		case TRACE_FRAME_END:	Emit(first, "frame", 'E', TID_MAIN, us, -1); break;
+		case TRACE_SPI_START:	Emit(first, e[3] ? "spi_async" : "spi", 'B', TID_SPI, us, -1); break;
+		case TRACE_SPI_END:		Emit(first, e[3] ? "spi_async" : "spi", 'E', TID_SPI, us, -1); break;
+		case TRACE_BALL_SPAWN:	Emit(first, "ball_spawn", 'i', TID_MAIN, us, e[3]); break;
+		case TRACE_SCORE:		Emit(first, "score", 'i', TID_MAIN, us, e[3]); break;
+		default:				Emit(first, "unknown", 'i', TID_MAIN, us, e[2]); break;
+		}
+		first = 0;
+	}
+	printf("\n]}\n");
+	return 0;
+}
+
+#endif /* __MSP430__ */
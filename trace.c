@@ -0,0 +1,54 @@
+/**
+ * @file trace.c
+ * @brief Zapis dogadjaja u kruzni bafer u RAM-u
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Dogadjaji se upisuju i iz prekidnih rutina i iz glavnog programa,
+ * pa se upis vrsi sa zabranjenim prekidima. Kada se bafer napuni,
+ * najstariji dogadjaji se prepisuju.
+ */
+#include "hal.h"
+#include "trace.h"
+
+#if TRACE_ENABLE
+
+/**
+ * Zapis dogadjaja
+ */
+TraceBuffer trace = {TRACE_MAGIC, 0, 0};
+
+/**
+ * @brief Upis jednog dogadjaja
+ * @param Tip dogadjaja
+ * @param Argument
+ */
+void Trace_Event(uint8_t type, uint8_t arg)
+{
+	hal_irq_t state;
+	TraceEvent *e;
+
+	HAL_IRQ_SAVE(state);
+	e = &trace.ev[trace.head];
+	e->ts = HAL_TIMESTAMP();
+	e->type = type;
+	e->arg = arg;
+	trace.head = (trace.head + 1) & (TRACE_SIZE - 1);
+	if(trace.count < TRACE_SIZE)
+		trace.count++;
+	HAL_IRQ_RESTORE(state);
+}
+
+/**
+ * @brief Brisanje zapisa
+ */
+void Trace_Clear(void)
+{
+	hal_irq_t state;
+	HAL_IRQ_SAVE(state);
+	trace.head = 0;
+	trace.count = 0;
+	HAL_IRQ_RESTORE(state);
+}
+
+#endif /* TRACE_ENABLE */
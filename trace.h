@@ -0,0 +1,97 @@
+/**
+ * @file trace.h
+ * @brief Zapis dogadjaja u kruzni bafer u RAM-u
+ * @author Jovan Blanusa, 47/2012 (jovan.blanusa@gmail.com)
+ * @date 2016
+ *
+ * Svaki dogadjaj zauzima 4 bajta: vreme (HAL_TIMESTAMP), tip i jedan
+ * bajt argumenta. Ceo zapis je u jednoj strukturi (trace), pa se iz
+ * debagera moze sacuvati kao jedan blok memorije i pretvoriti u Chrome
+ * trace JSON programom trace2json. Zapis se ukljucuje makroom
+ * TRACE_ENABLE; kada je iskljucen, makro TRACE se prevodi u nista.
+ */
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 0
+#endif
+
+/**
+ * Broj dogadjaja u baferu, mora biti stepen broja 2
+ */
+#define TRACE_SIZE 128
+
+/**
+ * Oznaka na pocetku zapisa ("TR")
+ */
+#define TRACE_MAGIC 0x5254
+
+/**
+ * Tipovi dogadjaja
+ */
+#define TRACE_TIMER_TICK   1	// prekid Timera A
+#define TRACE_ADC_ISR      2	// prekid AD konvertora
+#define TRACE_BUTTON_ISR   3	// prekid tastera
+#define TRACE_FRAME_START  4	// pocetak RefreshScreen
+#define TRACE_FRAME_END    5	// kraj RefreshScreen
+#define TRACE_SPI_START    6	// pocetak slanja na OLED, arg = 1 za asinhrono
+#define TRACE_SPI_END      7	// kraj slanja na OLED, arg = 1 za asinhrono
+#define TRACE_BALL_SPAWN   8	// nova loptica, arg = Y koordinata
+#define TRACE_SCORE        9	// poen, arg = igrac koji je osvojio poen
+
+/**
+ * Jedan dogadjaj
+ */
+typedef struct
+{
+	uint16_t ts;
+	uint8_t type;
+	uint8_t arg;
+} TraceEvent;
+
+/**
+ * Ceo zapis: zaglavlje i kruzni bafer. Najstariji dogadjaj je na
+ * indeksu (head - count) po modulu TRACE_SIZE.
+ */
+typedef struct
+{
+	uint16_t magic;
+	uint16_t head;		// indeks sledeceg dogadjaja
+	uint16_t count;		// broj vazecih dogadjaja
+	TraceEvent ev[TRACE_SIZE];
+} TraceBuffer;
+
+#if TRACE_ENABLE
+
+/**
+ * Zapis dogadjaja
+ */
+#define TRACE(type, arg)		Trace_Event(type, arg)
+
+/**
+ * Zapis dogadjaja
+ */
+extern TraceBuffer trace;
+
+/**
+ * @brief Upis jednog dogadjaja
+ * @param Tip dogadjaja
+ * @param Argument
+ */
+void Trace_Event(uint8_t, uint8_t);
+
+/**
+ * @brief Brisanje zapisa
+ */
+void Trace_Clear(void);
+
+#else
+
+#define TRACE(type, arg)
+
+#endif /* TRACE_ENABLE */
+
+#endif /* TRACE_H_ */